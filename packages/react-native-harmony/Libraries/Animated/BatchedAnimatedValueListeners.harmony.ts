@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import type { TurboModule } from '../TurboModule/RCTExport';
+import * as TurboModuleRegistry from '../TurboModule/TurboModuleRegistry';
+import type { Animated } from './Animated';
+import RCTDeviceEventEmitter from '../EventEmitter/RCTDeviceEventEmitter.js';
+
+type BatchedAnimatedValueListenerOptions = {
+  /**
+   * The minimum time between two values delivered to the listener. The latest
+   * value is delivered once the interval has passed. Defaults to 0: one value
+   * per frame at most.
+   */
+  throttleIntervalMs?: number;
+};
+
+interface Spec extends TurboModule {
+  startListeningToAnimatedNodeValue: (
+    tag: number,
+    config?: { batched: boolean; throttleIntervalMs: number }
+  ) => void;
+  stopListeningToAnimatedNodeValue: (tag: number) => void;
+}
+
+/**
+ * Native driver methods of AnimatedNode, which aren't part of its public
+ * typings.
+ */
+type NativeAnimatedNode = {
+  __makeNative(): void;
+  __getNativeTag(): number;
+};
+
+type Subscription = { remove(): void };
+
+const deviceEventEmitter = RCTDeviceEventEmitter as {
+  addListener(
+    eventType: string,
+    listener: (tagsAndValues: Float64Array) => void
+  ): Subscription;
+};
+
+const listenerByTag = new Map<number, (value: number) => void>();
+let valuesUpdateSubscription: Subscription | null = null;
+
+/**
+ * Native sends the values updated during a frame as one event: a
+ * Float64Array of interleaved (tag, value) pairs.
+ */
+function onAnimatedValuesUpdate(tagsAndValues: Float64Array) {
+  for (let i = 0; i + 1 < tagsAndValues.length; i += 2) {
+    listenerByTag.get(tagsAndValues[i])?.(tagsAndValues[i + 1]);
+  }
+}
+
+/**
+ * Listens to the values of a native driven Animated.Value, receiving at most
+ * one value per frame instead of one event per update. Replaces any
+ * `addListener` listening of the same value on the native side, so the two
+ * shouldn't be mixed.
+ */
+export function addBatchedAnimatedValueListener(
+  animatedValue: Animated.Value,
+  listener: (value: number) => void,
+  options: BatchedAnimatedValueListenerOptions = {}
+): { remove: () => void } {
+  const nativeAnimatedModule = TurboModuleRegistry.getEnforcing<Spec>(
+    'NativeAnimatedTurboModule'
+  );
+  const animatedNode = animatedValue as unknown as NativeAnimatedNode;
+  animatedNode.__makeNative();
+  const tag = animatedNode.__getNativeTag();
+  if (valuesUpdateSubscription === null) {
+    valuesUpdateSubscription = deviceEventEmitter.addListener(
+      'onAnimatedValuesUpdate',
+      onAnimatedValuesUpdate
+    );
+  }
+  listenerByTag.set(tag, listener);
+  nativeAnimatedModule.startListeningToAnimatedNodeValue(tag, {
+    batched: true,
+    throttleIntervalMs: options.throttleIntervalMs ?? 0,
+  });
+  return {
+    remove: () => {
+      if (listenerByTag.get(tag) !== listener) {
+        return;
+      }
+      listenerByTag.delete(tag);
+      nativeAnimatedModule.stopListeningToAnimatedNodeValue(tag);
+      if (listenerByTag.size === 0) {
+        valuesUpdateSubscription?.remove();
+        valuesUpdateSubscription = null;
+      }
+    },
+  };
+}
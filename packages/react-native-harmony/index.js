@@ -205,5 +205,9 @@ module.exports = {
     return require('./Libraries/Renderer/shims/ReactNative').default
       .dispatchCommand;
   },
+  get addBatchedAnimatedValueListener() {
+    return require('./Libraries/Animated/BatchedAnimatedValueListeners')
+      .addBatchedAnimatedValueListener;
+  },
   // END: react-native-harmony specific exports
 };
@@ -21,6 +21,7 @@
 #include "RNOH/ComponentInstanceFactory.h"
 #include "RNOH/ComponentInstancePreallocationRequestQueue.h"
 #include "RNOH/ComponentInstanceRegistry.h"
+#include "RNOH/ContinuousEventStats.h"
 #include "RNOH/CustomComponentArkUINodeHandleFactory.h"
 #include "RNOH/EventEmitRequestHandler.h"
 #include "RNOH/FeatureFlagRegistry.h"
@@ -29,30 +30,19 @@
 #include "RNOH/MountingManagerCAPI.h"
 #include "RNOH/MutationsToNapiConverter.h"
 #include "RNOH/PackageProvider.h"
+#include "RNOH/PackageRegistrations.h"
 #include "RNOH/Performance/RNOHMarker.h"
 #include "RNOH/RNInstance.h"
 #include "RNOH/RNInstanceCAPI.h"
 #include "RNOH/TaskExecutor/NapiTaskRunner.h"
 #include "RNOH/TextMeasurer.h"
+#include "RNOH/TextPreMeasurer.h"
 #include "RNOH/TurboModuleFactory.h"
 #include "RNOH/UITicker.h"
 #include "RNOHCorePackage/RNOHCorePackage.h"
 
 using namespace rnoh;
 
-class PackageToComponentInstanceFactoryDelegateAdapter
-    : public ComponentInstanceFactoryDelegate {
-  Package::Shared m_package;
-
- public:
-  PackageToComponentInstanceFactoryDelegateAdapter(Package::Shared package)
-      : m_package(std::move(package)) {}
-
-  ComponentInstance::Shared create(ComponentInstance::Context ctx) override {
-    return m_package->createComponentInstance(std::move(ctx));
-  };
-};
-
 std::shared_ptr<RNInstanceInternal> createRNInstance(
     int id,
     napi_env env,
@@ -102,77 +92,72 @@ std::shared_ptr<RNInstanceInternal> createRNInstance(
        fontPathByFontFamily) {
     fontRegistry->registerFont(fontFamilyName, fontPathRelativeToRawfileDir);
   }
+  auto sharedFontStats = FontRegistry::getSharedFontStats();
+  auto savedFontDataBytes = sharedFontStats.registeredFontDataBytes -
+      sharedFontStats.uniqueFontDataBytes;
+  DLOG(INFO) << "Font data shared across RN instances: "
+             << sharedFontStats.uniqueFontDataBytes << "B held, "
+             << savedFontDataBytes << "B saved";
+  auto textStorageCacheStats = TextMeasurer::getTextStorageCacheStats();
+  DLOG(INFO) << "Text storages shared across RN instances: "
+             << textStorageCacheStats.size << " ("
+             << textStorageCacheStats.bytes << "B), "
+             << textStorageCacheStats.hits << " hits ("
+             << textStorageCacheStats.sharedHits << " shared, "
+             << textStorageCacheStats.widthReuses << " width reuses), "
+             << textStorageCacheStats.misses << " misses";
+  auto measureCacheStats =
+      facebook::react::TextLayoutManager::getMeasureCacheStats();
+  DLOG(INFO) << "Text measurements cached: " << measureCacheStats.size << ", "
+             << measureCacheStats.exactHits << " exact hits, "
+             << measureCacheStats.constraintHits << " constraint hits, "
+             << measureCacheStats.misses << " misses";
+  DLOG(INFO) << "Continuous events emitted: "
+             << ContinuousEventStats::getEmittedEventsCount();
   auto textMeasurer =
       std::make_shared<TextMeasurer>(featureFlagRegistry, fontRegistry, id);
   auto shadowViewRegistry = std::make_shared<ShadowViewRegistry>();
   contextContainer->insert("textLayoutManagerDelegate", textMeasurer);
   RNOHMarker::logMarker(RNOHMarker::RNOHMarkerId::PROCESS_PACKAGES_START);
   PackageProvider packageProvider;
-  auto packages = packageProvider.getPackages({});
+  auto appPackages = packageProvider.getPackages({});
   RNOHMarker::logMarker(
       RNOHMarker::RNOHMarkerId::PROCESS_CORE_REACT_PACKAGE_START);
-  packages.insert(
-      packages.begin(),
-      std::make_shared<RNOHCorePackage>(
-          Package::Context{.shadowViewRegistry = shadowViewRegistry}));
+  auto corePackage = std::make_shared<RNOHCorePackage>(
+      Package::Context{.shadowViewRegistry = shadowViewRegistry});
+  // the core package goes first, so its binders take precedence
+  auto packageRegistrations = PackageRegistrations::collect(corePackage);
   RNOHMarker::logMarker(
       RNOHMarker::RNOHMarkerId::PROCESS_CORE_REACT_PACKAGE_END);
+  auto const& appComponentDescriptorProviders =
+      AppComponentDescriptorProviders::get(appPackages);
+  packageRegistrations.componentDescriptorProviders.insert(
+      packageRegistrations.componentDescriptorProviders.end(),
+      appComponentDescriptorProviders.begin(),
+      appComponentDescriptorProviders.end());
+  for (auto const& package : appPackages) {
+    packageRegistrations.merge(PackageRegistrations::collect(
+        package, /*shouldCollectComponentDescriptorProviders=*/false));
+  }
   auto componentDescriptorProviderRegistry =
       std::make_shared<facebook::react::ComponentDescriptorProviderRegistry>();
-  std::vector<std::shared_ptr<TurboModuleFactoryDelegate>>
-      turboModuleFactoryDelegates;
-  ComponentJSIBinderByString componentJSIBinderByName = {};
-  GlobalJSIBinders globalJSIBinders = {};
-  ComponentNapiBinderByString componentNapiBinderByName = {};
-  EventEmitRequestHandlers eventEmitRequestHandlers = {};
-  std::vector<ComponentInstanceFactoryDelegate::Shared>
-      componentInstanceFactoryDelegates = {};
-  std::vector<ArkTSMessageHandler::Shared> arkTSMessageHandlers = {};
-
-  for (auto& package : packages) {
-    auto turboModuleFactoryDelegate =
-        package->createTurboModuleFactoryDelegate();
-    if (turboModuleFactoryDelegate != nullptr) {
-      turboModuleFactoryDelegates.push_back(
-          std::move(turboModuleFactoryDelegate));
-    }
-    for (const auto& componentDescriptorProvider :
-         package->createComponentDescriptorProviders()) {
-      componentDescriptorProviderRegistry->add(componentDescriptorProvider);
-    }
-    for (const auto& [name, componentJSIBinder] :
-         package->createComponentJSIBinderByName()) {
-      componentJSIBinderByName.insert({name, componentJSIBinder});
-    };
-    for (const auto& [name, componentNapiBinder] :
-         package->createComponentNapiBinderByName()) {
-      componentNapiBinderByName.insert({name, componentNapiBinder});
-    };
-    auto deprecatedGlobalJSIBinders = package->createGlobalJSIBinders();
-    auto packageGlobalJSIBinders = package->createGlobalJSIBinders({});
-    globalJSIBinders.insert(
-        globalJSIBinders.end(),
-        std::make_move_iterator(deprecatedGlobalJSIBinders.begin()),
-        std::make_move_iterator(deprecatedGlobalJSIBinders.end()));
-    globalJSIBinders.insert(
-        globalJSIBinders.end(),
-        std::make_move_iterator(packageGlobalJSIBinders.begin()),
-        std::make_move_iterator(packageGlobalJSIBinders.end()));
-    auto packageEventEmitRequestHandlers =
-        package->createEventEmitRequestHandlers();
-    eventEmitRequestHandlers.insert(
-        eventEmitRequestHandlers.end(),
-        std::make_move_iterator(packageEventEmitRequestHandlers.begin()),
-        std::make_move_iterator(packageEventEmitRequestHandlers.end()));
-    auto componentInstanceFactoryDelegate =
-        package->createComponentInstanceFactoryDelegate();
-    if (componentInstanceFactoryDelegate != nullptr) {
-      componentInstanceFactoryDelegates.push_back(
-          std::move(componentInstanceFactoryDelegate));
-    }
-    componentInstanceFactoryDelegates.push_back(
-        std::make_shared<PackageToComponentInstanceFactoryDelegateAdapter>(
-            package));
+  for (auto const& componentDescriptorProvider :
+       packageRegistrations.componentDescriptorProviders) {
+    componentDescriptorProviderRegistry->add(componentDescriptorProvider);
+  }
+  auto turboModuleFactoryDelegates =
+      std::move(packageRegistrations.turboModuleFactoryDelegates);
+  auto componentJSIBinderByName =
+      std::move(packageRegistrations.componentJSIBinderByName);
+  auto globalJSIBinders = std::move(packageRegistrations.globalJSIBinders);
+  auto componentNapiBinderByName =
+      std::move(packageRegistrations.componentNapiBinderByName);
+  auto eventEmitRequestHandlers =
+      std::move(packageRegistrations.eventEmitRequestHandlers);
+  auto componentInstanceFactoryDelegates =
+      std::move(packageRegistrations.componentInstanceFactoryDelegates);
+  auto arkTSMessageHandlers = corePackage->createArkTSMessageHandlers();
+  for (auto const& package : appPackages) {
     for (auto const& arkTSMessageHandler :
          package->createArkTSMessageHandlers()) {
       arkTSMessageHandlers.push_back(arkTSMessageHandler);
@@ -276,6 +261,10 @@ std::shared_ptr<RNInstanceInternal> createRNInstance(
       std::move(jsEngineProvider),
       std::move(inspectorHostTarget));
   componentInstanceDependencies->rnInstance = rnInstance;
+  if (featureFlagRegistry->isFeatureFlagOn("TEXT_PRE_MEASUREMENT_ENABLED")) {
+    rnInstance->setTextPreMeasurer(
+        std::make_shared<TextPreMeasurer>(textMeasurer));
+  }
   auto imageSourceResolver =
       std::make_shared<ImageSourceResolver>(arkTSMessageHub, rnInstance);
   componentInstanceDependencies->imageSourceResolver = imageSourceResolver;
@@ -66,6 +66,15 @@ class ArkUITypography final {
     return OH_Drawing_TypographyGetLongestLine(m_typography.get()) / m_scale;
   }
 
+  /**
+   * @brief Distance from the top of the text to the baseline of its first
+   * line.
+   */
+  facebook::react::Float getAlphabeticBaseline() const {
+    return OH_Drawing_TypographyGetAlphabeticBaseline(m_typography.get()) /
+        m_scale;
+  }
+
   bool didExceedMaxLines() const {
     return OH_Drawing_TypographyDidExceedMaxLines(m_typography.get());
   }
@@ -106,7 +115,18 @@ class ArkUITypography final {
   }
 
   facebook::react::TextMeasurement getMeasurement() const {
-    facebook::react::Size clampedSize = m_layoutConstraints.clamp({
+    return getMeasurement(m_layoutConstraints);
+  }
+
+  /**
+   * @brief Measures the text for other layout constraints, which must give
+   * the same lines.
+   */
+  facebook::react::TextMeasurement getMeasurement(
+      facebook::react::LayoutConstraints layoutConstraints) const {
+    layoutConstraints.maximumSize.height =
+        std::numeric_limits<facebook::react::Float>::infinity();
+    facebook::react::Size clampedSize = layoutConstraints.clamp({
         .width = getLongestLineWidth(),
         .height = getHeight(),
     });
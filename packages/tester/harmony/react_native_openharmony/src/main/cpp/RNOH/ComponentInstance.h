@@ -10,6 +10,7 @@
  */
 #pragma once
 #include <react/renderer/components/view/ViewProps.h>
+#include <react/renderer/core/ComponentDescriptor.h>
 #include <react/renderer/core/EventEmitter.h>
 #include <react/renderer/core/LayoutMetrics.h>
 #include <react/renderer/core/Props.h>
@@ -20,6 +21,7 @@
 #include "RNOH/ArkTSMessageHub.h"
 #include "RNOH/DisplayMetricsManager.h"
 #include "RNOH/ImageSourceResolver.h"
+#include "RNOH/PropKeySet.h"
 #include "RNOH/RNInstance.h"
 #include "RNOH/TaskExecutor/TaskExecutor.h"
 #include "RNOH/TouchTarget.h"
@@ -464,17 +466,50 @@ class ComponentInstance
   /**
    * @internal
    */
-  void setIgnoredPropKeys(std::unordered_set<std::string> propKeys) {
+  void setIgnoredPropKeys(PropKeySet propKeys) {
     m_ignoredPropKeys = std::move(propKeys);
   }
 
   /**
    * @internal
    */
-  std::unordered_set<std::string> const& getIgnoredPropKeys() const {
+  PropKeySet const& getIgnoredPropKeys() const {
     return m_ignoredPropKeys;
   }
 
+  /**
+   * @internal
+   */
+  void setSurfaceId(facebook::react::SurfaceId surfaceId) {
+    m_surfaceId = surfaceId;
+  }
+
+  /**
+   * @internal
+   * @return the id of the surface the component was created in, if known
+   */
+  std::optional<facebook::react::SurfaceId> getSurfaceId() const {
+    return m_surfaceId;
+  }
+
+  /**
+   * @internal
+   * Caches the descriptor of the component, so that updates made outside of
+   * a commit (e.g. by Animated) don't look it up on every frame. Component
+   * descriptors outlive component instances of the same RN instance.
+   */
+  void setComponentDescriptor(
+      facebook::react::ComponentDescriptor const* componentDescriptor) {
+    m_componentDescriptor = componentDescriptor;
+  }
+
+  /**
+   * @internal
+   */
+  facebook::react::ComponentDescriptor const* getComponentDescriptor() const {
+    return m_componentDescriptor;
+  }
+
   /**
    * @deprecated: It's no longer part of the API. Do NOT use it. Use downcasting
    * instead.
@@ -568,7 +603,15 @@ class ComponentInstance
   /**
    * @internal
    */
-  std::unordered_set<std::string> m_ignoredPropKeys;
+  PropKeySet m_ignoredPropKeys;
+  /**
+   * @internal
+   */
+  std::optional<facebook::react::SurfaceId> m_surfaceId;
+  /**
+   * @internal
+   */
+  facebook::react::ComponentDescriptor const* m_componentDescriptor = nullptr;
   /**
    * @actor RNOH_LIBRARY
    * RNInstance ID
@@ -16,6 +16,7 @@
 #include <react/renderer/core/ReactPrimitives.h>
 #include "RNOH/Assert.h"
 #include "RNOH/ComponentInstance.h"
+#include "RNOH/TagIndexedMap.h"
 
 namespace rnoh {
 /**
@@ -35,9 +36,9 @@ class ComponentInstanceRegistry : public ComponentInstance::Registry {
 
   ComponentInstance::Shared findByTag(facebook::react::Tag tag) const {
     assertMainThread();
-    auto it = m_componentInstanceByTag.find(tag);
-    if (it != m_componentInstanceByTag.end()) {
-      return it->second;
+    auto componentInstance = m_componentInstanceByTag.find(tag);
+    if (componentInstance != nullptr) {
+      return *componentInstance;
     }
     return nullptr;
   }
@@ -63,7 +64,10 @@ class ComponentInstanceRegistry : public ComponentInstance::Registry {
   void insert(ComponentInstance::Shared componentInstance) {
     assertMainThread();
     auto tag = componentInstance->getTag();
-    m_componentInstanceByTag.emplace(tag, std::move(componentInstance));
+    if (!m_componentInstanceByTag.contains(tag)) {
+      m_componentInstanceByTag.insertOrAssign(
+          tag, std::move(componentInstance));
+    }
   }
 
   void updateTagById(
@@ -81,22 +85,19 @@ class ComponentInstanceRegistry : public ComponentInstance::Registry {
 
   void deleteByTag(facebook::react::Tag tag) {
     assertMainThread();
-    auto tagAndComponentInstance = m_componentInstanceByTag.find(tag);
-    if (tagAndComponentInstance == m_componentInstanceByTag.end()) {
+    auto componentInstance = m_componentInstanceByTag.erase(tag);
+    if (!componentInstance.has_value()) {
       return;
     }
-    const auto& componentInstance = tagAndComponentInstance->second;
-    auto componentInstanceId = componentInstance->getId();
+    auto componentInstanceId = (*componentInstance)->getId();
     if (!componentInstanceId.empty()) {
       m_tagById.erase(componentInstanceId);
     }
-    m_componentInstanceByTag.erase(tag);
   }
 
  private:
   std::thread::id m_mainThreadId = std::this_thread::get_id();
-  std::unordered_map<facebook::react::Tag, ComponentInstance::Shared>
-      m_componentInstanceByTag = {};
+  TagIndexedMap<ComponentInstance::Shared> m_componentInstanceByTag;
   std::unordered_map<std::string, facebook::react::Tag> m_tagById = {};
 
   void assertMainThread() const {
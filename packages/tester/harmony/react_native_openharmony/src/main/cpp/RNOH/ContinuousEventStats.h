@@ -0,0 +1,37 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * Process-wide count of continuous events (e.g. scroll) emitted to Fabric.
+ * Such events are dispatched as unique events, so Fabric's EventQueue keeps
+ * only the latest one per target and event name until the EventBeat flushes
+ * it; the queue doesn't report how many were replaced.
+ */
+class ContinuousEventStats {
+ public:
+  static void recordEmittedEvent() {
+    s_emittedEventsCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static uint64_t getEmittedEventsCount() {
+    return s_emittedEventsCount.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static inline std::atomic<uint64_t> s_emittedEventsCount{0};
+};
+
+} // namespace rnoh
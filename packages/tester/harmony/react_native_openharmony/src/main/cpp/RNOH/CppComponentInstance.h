@@ -458,8 +458,9 @@ class CppComponentInstance : public ComponentInstance,
     auto old =
         std::static_pointer_cast<const facebook::react::ViewProps>(m_props);
     RNOH_ASSERT(old != nullptr);
+    static auto const transformPropKeyId = internPropKey("transform");
     auto isTransformManagedByAnimated =
-        getIgnoredPropKeys().count("transform") > 0;
+        getIgnoredPropKeys().contains(transformPropKeyId);
     if (*(props->backgroundColor) != *(old->backgroundColor)) {
       localRoot.setBackgroundColor(props->backgroundColor);
     }
@@ -706,9 +707,12 @@ class CppComponentInstance : public ComponentInstance,
       facebook::react::Transform::Identity();
 
   void setOpacity(facebook::react::SharedViewProps const& props) {
-    auto isOpacityManagedByAnimated = getIgnoredPropKeys().count("opacity") > 0;
+    static auto const opacityPropKeyId = internPropKey("opacity");
+    static auto const transformPropKeyId = internPropKey("transform");
+    auto isOpacityManagedByAnimated =
+        getIgnoredPropKeys().contains(opacityPropKeyId);
     auto isTransformManagedByAnimated =
-        getIgnoredPropKeys().count("transform") > 0;
+        getIgnoredPropKeys().contains(transformPropKeyId);
     bool shouldSetOpacity = true;
 
     if (isOpacityManagedByAnimated) {
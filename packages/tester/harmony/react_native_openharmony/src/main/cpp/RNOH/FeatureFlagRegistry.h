@@ -6,29 +6,71 @@
  */
 
 #pragma once
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 
 class FeatureFlagRegistry {
- private:
-  std::unordered_map<std::string, bool> flagStatusByName;
-  mutable std::mutex mtx;
-
  public:
   using Shared = std::shared_ptr<FeatureFlagRegistry>;
 
+  /**
+   * A handle to a single flag, resolved once by name. Reading it is a single
+   * relaxed atomic load — no locking and no string hashing — so it can be used
+   * on hot paths on any thread. The handle must not outlive the registry that
+   * created it.
+   */
+  class FeatureFlag {
+   public:
+    bool isOn() const {
+      return m_status->load(std::memory_order_relaxed);
+    }
+
+   private:
+    friend class FeatureFlagRegistry;
+
+    explicit FeatureFlag(std::atomic<bool> const* status) : m_status(status) {}
+
+    std::atomic<bool> const* m_status;
+  };
+
   void setFeatureFlagStatus(const std::string& name, bool status) {
     std::lock_guard<std::mutex> lock(mtx);
-    flagStatusByName[name] = status;
+    getOrCreateStatus(name).store(status, std::memory_order_relaxed);
   }
 
   bool isFeatureFlagOn(const std::string& name) const {
     std::lock_guard<std::mutex> lock(mtx);
     auto it = flagStatusByName.find(name);
     if (it != flagStatusByName.end()) {
-      return it->second;
+      return it->second->load(std::memory_order_relaxed);
     }
     return false;
   }
-};
\ No newline at end of file
+
+  /**
+   * Returns a handle to the flag. Flags that haven't been set yet are
+   * registered as off and follow later setFeatureFlagStatus calls.
+   */
+  FeatureFlag getFeatureFlag(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return FeatureFlag(&getOrCreateStatus(name));
+  }
+
+ private:
+  std::atomic<bool>& getOrCreateStatus(const std::string& name) {
+    auto& status = flagStatusByName[name];
+    if (status == nullptr) {
+      status = std::make_unique<std::atomic<bool>>(false);
+    }
+    return *status;
+  }
+
+  // statuses are heap-allocated so that FeatureFlag handles stay valid when
+  // the map rehashes
+  std::unordered_map<std::string, std::unique_ptr<std::atomic<bool>>>
+      flagStatusByName;
+  mutable std::mutex mtx;
+};
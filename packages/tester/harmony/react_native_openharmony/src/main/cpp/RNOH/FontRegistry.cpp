@@ -9,8 +9,10 @@
 #include <glog/logging.h>
 #include <native_drawing/drawing_register_font.h>
 #include <rawfile/raw_file_manager.h>
+#include <algorithm>
 #include <fstream>
 #include <mutex>
+#include <sstream>
 #include <string_view>
 #include "RNOHError.h"
 
@@ -50,6 +52,74 @@ std::vector<uint8_t> readSandboxFile(std::string const& absoluteFontFilePath) {
   return buffer;
 }
 
+namespace {
+
+/**
+ * Font data and font collections shared by all FontRegistries. Entries are
+ * weak, so the resources are released together with the last registry that
+ * uses them.
+ */
+struct SharedFontResources {
+  std::mutex mtx;
+  std::unordered_multimap<size_t, std::weak_ptr<const std::vector<uint8_t>>>
+      fontDataByContentHash;
+  std::unordered_map<std::string, std::weak_ptr<OH_Drawing_FontCollection>>
+      fontCollectionByFontSet;
+};
+
+SharedFontResources& getSharedFontResources() {
+  static SharedFontResources sharedFontResources;
+  return sharedFontResources;
+}
+
+SharedFontData deduplicateFontData(std::vector<uint8_t> fontData) {
+  auto contentHash = std::hash<std::string_view>{}(std::string_view(
+      reinterpret_cast<const char*>(fontData.data()), fontData.size()));
+  auto& resources = getSharedFontResources();
+  auto lock = std::lock_guard(resources.mtx);
+  auto [begin, end] = resources.fontDataByContentHash.equal_range(contentHash);
+  for (auto it = begin; it != end;) {
+    auto sharedFontData = it->second.lock();
+    if (sharedFontData == nullptr) {
+      it = resources.fontDataByContentHash.erase(it);
+      continue;
+    }
+    if (*sharedFontData == fontData) {
+      return sharedFontData;
+    }
+    it++;
+  }
+  auto sharedFontData =
+      std::make_shared<const std::vector<uint8_t>>(std::move(fontData));
+  resources.fontDataByContentHash.emplace(contentHash, sharedFontData);
+  return sharedFontData;
+}
+
+} // namespace
+
+FontRegistry::SharedFontStats FontRegistry::getSharedFontStats() {
+  auto& resources = getSharedFontResources();
+  auto lock = std::lock_guard(resources.mtx);
+  SharedFontStats stats{};
+  for (auto& [contentHash, weakFontData] : resources.fontDataByContentHash) {
+    if (auto fontData = weakFontData.lock()) {
+      // the use count includes the local `fontData`
+      auto usersCount = static_cast<size_t>(fontData.use_count() - 1);
+      stats.uniqueFontDataBytes += fontData->size();
+      stats.registeredFontDataBytes += fontData->size() * usersCount;
+    }
+  }
+  for (auto& [fontSet, weakFontCollection] :
+       resources.fontCollectionByFontSet) {
+    auto usersCount = static_cast<size_t>(weakFontCollection.use_count());
+    if (usersCount > 0) {
+      stats.fontCollectionsCount++;
+      stats.fontCollectionUsersCount += usersCount;
+    }
+  }
+  return stats;
+}
+
 FontRegistry::FontRegistry(
     std::weak_ptr<NativeResourceManager> weakResourceManager)
     : m_weakResourceManager(std::move(weakResourceManager)) {}
@@ -74,8 +144,10 @@ void FontRegistry::addFontData(
     const std::string& name,
     std::vector<uint8_t> fontData) {
   m_threadGuard.assertThread();
+  auto sharedFontData = deduplicateFontData(std::move(fontData));
   auto lock = std::lock_guard(m_fontFileContentByFontFamilyMtx);
-  m_fontFileContentByFontFamily.insert_or_assign(name, std::move(fontData));
+  m_fontFileContentByFontFamily.insert_or_assign(
+      name, std::move(sharedFontData));
   // NOTE: fonts cannot be added to an existing collection, so we need to
   // recreate it the next time `getFontCollection` is called
   auto fontCollectionLock = std::lock_guard(m_fontCollectionMtx);
@@ -87,17 +159,41 @@ SharedFontCollection FontRegistry::getFontCollection() {
   if (m_fontCollection) {
     return m_fontCollection;
   }
-  SharedFontCollection fontCollection(
-      OH_Drawing_CreateSharedFontCollection(),
-      OH_Drawing_DestroyFontCollection);
   auto lock = std::lock_guard(m_fontFileContentByFontFamilyMtx);
+  // font data is deduplicated, so registries with the same fonts produce the
+  // same key and share one collection
+  std::vector<std::pair<std::string_view, const void*>> fontSet;
+  fontSet.reserve(m_fontFileContentByFontFamily.size());
   for (auto& [name, fileContent] : m_fontFileContentByFontFamily) {
-    OH_Drawing_RegisterFontBuffer(
-        fontCollection.get(),
-        name.c_str(),
-        fileContent.data(),
-        fileContent.size());
+    fontSet.emplace_back(name, fileContent.get());
+  }
+  std::sort(fontSet.begin(), fontSet.end());
+  std::stringstream fontSetKey;
+  for (auto& [name, fileContent] : fontSet) {
+    fontSetKey << name << '\0' << fileContent << '\0';
+  }
+
+  auto& resources = getSharedFontResources();
+  auto resourcesLock = std::lock_guard(resources.mtx);
+  auto& weakFontCollection =
+      resources.fontCollectionByFontSet[fontSetKey.str()];
+  auto fontCollection = weakFontCollection.lock();
+  if (fontCollection == nullptr) {
+    fontCollection = SharedFontCollection(
+        OH_Drawing_CreateSharedFontCollection(),
+        OH_Drawing_DestroyFontCollection);
+    for (auto& [name, fileContent] : m_fontFileContentByFontFamily) {
+      OH_Drawing_RegisterFontBuffer(
+          fontCollection.get(),
+          name.c_str(),
+          const_cast<uint8_t*>(fileContent->data()),
+          fileContent->size());
+    }
+    weakFontCollection = fontCollection;
   }
+  std::erase_if(resources.fontCollectionByFontSet, [](auto const& entry) {
+    return entry.second.expired();
+  });
   m_fontCollection = fontCollection;
   return fontCollection;
 }
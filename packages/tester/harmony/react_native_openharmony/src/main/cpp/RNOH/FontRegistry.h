@@ -22,6 +22,12 @@ namespace rnoh {
  */
 using SharedFontCollection = std::shared_ptr<OH_Drawing_FontCollection>;
 
+/**
+ * @internal
+ * Font file content, deduplicated across all FontRegistries in the process.
+ */
+using SharedFontData = std::shared_ptr<const std::vector<uint8_t>>;
+
 /**
  * @internal
  * @thread: MAIN
@@ -36,8 +42,7 @@ class FontRegistry {
   bool isValidThemeFont(const std::filesystem::directory_entry& entry) const;
 
   std::weak_ptr<NativeResourceManager> m_weakResourceManager;
-  std::unordered_map<std::string, std::vector<uint8_t>>
-      m_fontFileContentByFontFamily;
+  std::unordered_map<std::string, SharedFontData> m_fontFileContentByFontFamily;
   std::mutex m_fontFileContentByFontFamilyMtx;
   ThreadGuard m_threadGuard;
   std::mutex m_fontCollectionMtx;
@@ -48,6 +53,23 @@ class FontRegistry {
  public:
   using Shared = std::shared_ptr<FontRegistry>;
 
+  struct SharedFontStats {
+    // font file bytes held in memory by the process
+    size_t uniqueFontDataBytes;
+    // font file bytes that FontRegistries would hold without deduplication
+    size_t registeredFontDataBytes;
+    size_t fontCollectionsCount;
+    size_t fontCollectionUsersCount;
+  };
+
+  /**
+   * Font files with the same content and font collections with the same set
+   * of fonts are shared by all RN instances in the process. They are released
+   * once no instance uses them.
+   * @threadSafe
+   */
+  static SharedFontStats getSharedFontStats();
+
   FontRegistry(std::weak_ptr<NativeResourceManager> weakResourceManager);
 
   void registerFont(const std::string& name, const std::string& fontFilePath);
@@ -8,6 +8,8 @@
 #include "JSVMInstance.h"
 #include "JSVMRuntimeTargetDelegate.h"
 
+#include <folly/Conv.h>
+#include <glog/logging.h>
 #include <jsi/jsi.h>
 #include <jsi/jsilib.h>
 #include <jsinspector-modern/InspectorFlags.h>
@@ -21,6 +23,10 @@ using namespace facebook::react;
 
 namespace jsvm {
 
+// e.g. "--rnoh-microtask-time-budget-us=4000"
+static const std::string MICROTASK_TIME_BUDGET_OPTION =
+    "--rnoh-microtask-time-budget-us=";
+
 class JSVMJSRuntime : public JSRuntime {
  public:
   JSVMJSRuntime(std::unique_ptr<JSVMRuntime> runtime)
@@ -54,9 +60,38 @@ std::unique_ptr<JSRuntime> JSVMInstance::createJSRuntime(
     folly::dynamic initOptions) noexcept {
   assert(msgQueueThread != nullptr);
 
+  // RNOH's own options share the list with the JSVM flags, but aren't passed
+  // to the VM
+  std::optional<std::chrono::microseconds> microtaskTimeBudget;
+  folly::dynamic vmInitOptions = folly::dynamic::array;
+  if (initOptions.isArray()) {
+    for (auto& option : initOptions) {
+      if (!option.isString()) {
+        LOG(WARNING) << "Ignoring JSVM init option of type "
+                     << option.typeName();
+        continue;
+      }
+      auto optionString = option.asString();
+      if (optionString.rfind(MICROTASK_TIME_BUDGET_OPTION, 0) != 0) {
+        vmInitOptions.push_back(std::move(optionString));
+        continue;
+      }
+      auto budget = folly::tryTo<int64_t>(
+          optionString.substr(MICROTASK_TIME_BUDGET_OPTION.size()));
+      if (budget.hasValue()) {
+        microtaskTimeBudget = std::chrono::microseconds(budget.value());
+      } else {
+        LOG(WARNING) << "Invalid JSVM init option: " << optionString;
+      }
+    }
+  }
+
   std::unique_ptr<JSVMRuntime> jsvmRuntime;
   msgQueueThread->runOnQueueSync([&]() {
-    jsvmRuntime = std::make_unique<JSVMRuntime>(msgQueueThread, initOptions);
+    jsvmRuntime = std::make_unique<JSVMRuntime>(msgQueueThread, vmInitOptions);
+    if (microtaskTimeBudget.has_value()) {
+      jsvmRuntime->setMicrotaskTimeBudget(microtaskTimeBudget.value());
+    }
   });
 
   return std::make_unique<JSVMJSRuntime>(std::move(jsvmRuntime));
@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "JSVMInstrumentation.h"
+#include <folly/dynamic.h>
+#include <folly/json.h>
+#include <glog/logging.h>
+#include <algorithm>
+#include <fstream>
+
+namespace jsvm {
+
+using JSINativeException = facebook::jsi::JSINativeException;
+
+JSVMInstrumentation::JSVMInstrumentation(
+    JSVM_VM vm,
+    JSVM_Env env,
+    std::function<void()> trimCaches)
+    : vm(vm), env(env), trimCaches(std::move(trimCaches)) {}
+
+std::string JSVMInstrumentation::getRecordedGCStats() {
+  folly::dynamic stats = folly::dynamic::object;
+  stats["numCollections"] = static_cast<int64_t>(collectionsCount);
+  stats["totalTimeUs"] = static_cast<int64_t>(totalCollectionTime.count());
+  stats["longestTimeUs"] =
+      static_cast<int64_t>(longestCollectionTime.count());
+  stats["lastCause"] = lastCollectionCause;
+  folly::dynamic heapInfo = folly::dynamic::object;
+  for (auto& [name, value] : getHeapInfo(false)) {
+    heapInfo[name] = value;
+  }
+  stats["heapInfo"] = std::move(heapInfo);
+  return folly::toJson(stats);
+}
+
+std::unordered_map<std::string, int64_t> JSVMInstrumentation::getHeapInfo(
+    bool /* includeExpensive */) {
+  std::unordered_map<std::string, int64_t> heapInfo{
+      {"jsvm_numCollections", static_cast<int64_t>(collectionsCount)},
+      {"jsvm_gcTimeUs", static_cast<int64_t>(totalCollectionTime.count())},
+  };
+  JSVM_HeapStatistics heapStatistics{};
+  if (OH_JSVM_GetHeapStatistics(vm, &heapStatistics) != JSVM_OK) {
+    LOG(WARNING) << "JSVM GetHeapStatistics failed";
+    return heapInfo;
+  }
+  heapInfo["jsvm_totalHeapSize"] = heapStatistics.totalHeapSize;
+  heapInfo["jsvm_totalHeapSizeExecutable"] =
+      heapStatistics.totalHeapSizeExecutable;
+  heapInfo["jsvm_totalPhysicalSize"] = heapStatistics.totalPhysicalSize;
+  heapInfo["jsvm_totalAvailableSize"] = heapStatistics.totalAvailableSize;
+  heapInfo["jsvm_usedHeapSize"] = heapStatistics.usedHeapSize;
+  heapInfo["jsvm_heapSizeLimit"] = heapStatistics.heapSizeLimit;
+  heapInfo["jsvm_mallocedMemory"] = heapStatistics.mallocedMemory;
+  heapInfo["jsvm_externalMemory"] = heapStatistics.externalMemory;
+  heapInfo["jsvm_peakMallocedMemory"] = heapStatistics.peakMallocedMemory;
+  heapInfo["jsvm_numberOfNativeContexts"] =
+      heapStatistics.numberOfNativeContexts;
+  heapInfo["jsvm_numberOfDetachedContexts"] =
+      heapStatistics.numberOfDetachedContexts;
+  heapInfo["jsvm_totalGlobalHandlesSize"] =
+      heapStatistics.totalGlobalHandlesSize;
+  heapInfo["jsvm_usedGlobalHandlesSize"] =
+      heapStatistics.usedGlobalHandlesSize;
+  return heapInfo;
+}
+
+void JSVMInstrumentation::collectGarbage(std::string cause) {
+  auto start = std::chrono::steady_clock::now();
+  if (trimCaches) {
+    trimCaches();
+  }
+  // a critical memory pressure notification makes JSVM run a full GC
+  auto status = OH_JSVM_MemoryPressureNotification(
+      env, JSVM_MEMORY_PRESSURE_LEVEL_CRITICAL);
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  if (status != JSVM_OK) {
+    LOG(WARNING) << "JSVM MemoryPressureNotification failed: " << status;
+    return;
+  }
+  collectionsCount++;
+  totalCollectionTime += duration;
+  longestCollectionTime = std::max(longestCollectionTime, duration);
+  lastCollectionCause = std::move(cause);
+  LOG(INFO) << "JSVM collected garbage (" << lastCollectionCause << ") in "
+            << duration.count() << "us";
+}
+
+void JSVMInstrumentation::startTrackingHeapObjectStackTraces(
+    std::function<void(
+        uint64_t,
+        std::chrono::microseconds,
+        std::vector<HeapStatsUpdate>&)>) {
+  throw JSINativeException(
+      "JSVM doesn't support tracking heap object stack traces");
+}
+
+void JSVMInstrumentation::stopTrackingHeapObjectStackTraces() {
+  throw JSINativeException(
+      "JSVM doesn't support tracking heap object stack traces");
+}
+
+void JSVMInstrumentation::startHeapSampling(size_t) {
+  throw JSINativeException("JSVM doesn't support heap sampling");
+}
+
+void JSVMInstrumentation::stopHeapSampling(std::ostream&) {
+  throw JSINativeException("JSVM doesn't support heap sampling");
+}
+
+void JSVMInstrumentation::createSnapshotToFile(
+    const std::string& path,
+    const HeapSnapshotOptions& options) {
+  std::ofstream os(path, std::ios::binary);
+  if (!os.is_open()) {
+    throw JSINativeException("Failed to open heap snapshot file: " + path);
+  }
+  createSnapshotToStream(os, options);
+}
+
+void JSVMInstrumentation::createSnapshotToStream(
+    std::ostream& os,
+    const HeapSnapshotOptions&) {
+  auto writeChunk = [](const char* data, int size, void* streamData) {
+    auto stream = static_cast<std::ostream*>(streamData);
+    if (size > 0) {
+      stream->write(data, size);
+    }
+    return stream->good();
+  };
+  if (OH_JSVM_TakeHeapSnapshot(vm, writeChunk, &os) != JSVM_OK) {
+    throw JSINativeException("JSVM TakeHeapSnapshot failed");
+  }
+}
+
+std::string JSVMInstrumentation::flushAndDisableBridgeTrafficTrace() {
+  throw JSINativeException("JSVM doesn't support bridge traffic tracing");
+}
+
+void JSVMInstrumentation::writeBasicBlockProfileTraceToFile(
+    const std::string&) const {
+  throw JSINativeException("JSVM doesn't support basic block profiling");
+}
+
+void JSVMInstrumentation::dumpProfilerSymbolsToFile(const std::string&) const {
+  throw JSINativeException("JSVM doesn't support dumping profiler symbols");
+}
+
+} // namespace jsvm
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef JSVMINSTRUMENTATION_H
+#define JSVMINSTRUMENTATION_H
+#include <chrono>
+#include <functional>
+#include "ark_runtime/jsvm.h"
+#include "common.h"
+
+namespace jsvm {
+
+/**
+ * jsi::Instrumentation backed by the JSVM heap statistics and heap snapshot
+ * APIs. JSVM doesn't report the collections it schedules on its own, so GC
+ * counts and timings cover the collections requested through
+ * collectGarbage(), e.g. by ReactInstance::handleMemoryPressureJs.
+ *
+ * @thread: JS
+ */
+class JSVMInstrumentation : public Instrumentation {
+ public:
+  /**
+   * @param trimCaches releases memory cached by the runtime, called before
+   * every requested collection
+   */
+  JSVMInstrumentation(
+      JSVM_VM vm,
+      JSVM_Env env,
+      std::function<void()> trimCaches);
+
+  std::string getRecordedGCStats() override;
+
+  std::unordered_map<std::string, int64_t> getHeapInfo(
+      bool includeExpensive) override;
+
+  void collectGarbage(std::string cause) override;
+
+  void startTrackingHeapObjectStackTraces(
+      std::function<void(
+          uint64_t lastSeenObjectID,
+          std::chrono::microseconds timestamp,
+          std::vector<HeapStatsUpdate>& stats)> fragmentCallback) override;
+  void stopTrackingHeapObjectStackTraces() override;
+
+  void startHeapSampling(size_t samplingInterval) override;
+  void stopHeapSampling(std::ostream& os) override;
+
+  void createSnapshotToFile(
+      const std::string& path,
+      const HeapSnapshotOptions& options) override;
+  void createSnapshotToStream(
+      std::ostream& os,
+      const HeapSnapshotOptions& options) override;
+
+  std::string flushAndDisableBridgeTrafficTrace() override;
+
+  void writeBasicBlockProfileTraceToFile(
+      const std::string& fileName) const override;
+  void dumpProfilerSymbolsToFile(const std::string& fileName) const override;
+
+ private:
+  JSVM_VM vm;
+  JSVM_Env env;
+  std::function<void()> trimCaches;
+  uint64_t collectionsCount = 0;
+  std::chrono::microseconds totalCollectionTime{0};
+  std::chrono::microseconds longestCollectionTime{0};
+  std::string lastCollectionCause;
+};
+
+} // namespace jsvm
+
+#endif // JSVMINSTRUMENTATION_H
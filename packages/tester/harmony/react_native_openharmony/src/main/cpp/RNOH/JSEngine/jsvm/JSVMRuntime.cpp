@@ -6,6 +6,7 @@
  */
 
 #include "JSVMRuntime.h"
+#include <folly/ScopeGuard.h>
 #include <glog/logging.h>
 #include <filesystem>
 #include <fstream>
@@ -28,6 +29,105 @@ std::mutex JSVMRuntime::codeCacheMtx;
 std::unordered_map<std::string, std::vector<uint8_t>> JSVMRuntime::codeCacheL2 =
     {};
 thread_local bool JSVMPointerValue::isJsThread = false;
+std::atomic<size_t> JSVMPointerValue::liveCount{0};
+
+namespace {
+/**
+ * Free list of JSVMPointerValue-sized blocks. Blocks freed on a thread are
+ * reused by the next allocations on that thread; once the list holds
+ * MAX_FREE_BLOCKS, further blocks go back to the system allocator.
+ */
+class PointerValueFreeList {
+  struct Block {
+    Block* next;
+  };
+  static constexpr size_t MAX_FREE_BLOCKS = 4096;
+
+ public:
+  ~PointerValueFreeList() {
+    while (head != nullptr) {
+      auto block = head;
+      head = block->next;
+      ::operator delete(block);
+    }
+  }
+
+  void* allocate() {
+    if (head == nullptr) {
+      return ::operator new(sizeof(JSVMPointerValue));
+    }
+    auto block = head;
+    head = block->next;
+    freeBlocksCount--;
+    return block;
+  }
+
+  void deallocate(void* ptr) {
+    if (freeBlocksCount >= MAX_FREE_BLOCKS) {
+      ::operator delete(ptr);
+      return;
+    }
+    auto block = static_cast<Block*>(ptr);
+    block->next = head;
+    head = block;
+    freeBlocksCount++;
+  }
+
+ private:
+  Block* head = nullptr;
+  size_t freeBlocksCount = 0;
+};
+
+static_assert(sizeof(JSVMPointerValue) >= sizeof(void*));
+
+thread_local PointerValueFreeList pointerValueFreeList;
+} // namespace
+
+void* JSVMPointerValue::operator new(size_t size) {
+  if (unlikely(size != sizeof(JSVMPointerValue))) {
+    return ::operator new(size);
+  }
+  return pointerValueFreeList.allocate();
+}
+
+void JSVMPointerValue::operator delete(void* ptr, size_t size) {
+  if (unlikely(size != sizeof(JSVMPointerValue))) {
+    ::operator delete(ptr);
+    return;
+  }
+  pointerValueFreeList.deallocate(ptr);
+}
+
+void JSVMDeferredReleaseQueue::push(JSVMPointerValue* pointerValue) {
+  pendingCount.fetch_add(1, std::memory_order_relaxed);
+  auto previousHead = head.load(std::memory_order_relaxed);
+  do {
+    pointerValue->nextPendingRelease = previousHead;
+  } while (!head.compare_exchange_weak(
+      previousHead,
+      pointerValue,
+      std::memory_order_release,
+      std::memory_order_relaxed));
+  if (previousHead != nullptr) {
+    // a drain is already scheduled and will pick this value up
+    return;
+  }
+  jsQueue->runOnQueue([weakSelf = weak_from_this()] {
+    if (auto self = weakSelf.lock()) {
+      self->drain();
+    }
+  });
+}
+
+void JSVMDeferredReleaseQueue::drain() {
+  auto pointerValue = head.exchange(nullptr, std::memory_order_acquire);
+  while (pointerValue != nullptr) {
+    auto next = pointerValue->nextPendingRelease;
+    pointerValue->release();
+    pendingCount.fetch_sub(1, std::memory_order_relaxed);
+    pointerValue = next;
+  }
+}
 
 JSVMRuntime::JSVMRuntime(folly::dynamic initOptions)
     : hostObjectClass(nullptr) {
@@ -61,6 +161,8 @@ JSVMRuntime::JSVMRuntime(folly::dynamic initOptions)
   OH_JSVM_OpenVMScope(vm, &vmScope);
   OH_JSVM_CreateEnv(vm, 0, nullptr, &env);
   OH_JSVM_OpenEnvScope(env, &envScope);
+  jsvmInstrumentation = std::make_unique<JSVMInstrumentation>(
+      vm, env, [this] { trimCaches(); });
 }
 
 JSVMRuntime::JSVMRuntime(
@@ -68,15 +170,18 @@ JSVMRuntime::JSVMRuntime(
     folly::dynamic initOptions)
     : JSVMRuntime(initOptions) {
   this->jsQueue = jsQueue;
+  pointerValueReleaseQueue =
+      std::make_shared<JSVMDeferredReleaseQueue>(jsQueue);
   OH_JSVM_SetInstanceData(
-      env,
-      reinterpret_cast<facebook::react::MessageQueueThread*>(jsQueue.get()),
-      nullptr,
-      nullptr);
+      env, pointerValueReleaseQueue.get(), nullptr, nullptr);
 }
 
 JSVMRuntime::~JSVMRuntime() {
   microtaskQueue_.clear();
+  clearInternedPropNames();
+  if (pointerValueReleaseQueue != nullptr) {
+    pointerValueReleaseQueue->drain();
+  }
   OH_JSVM_CloseEnvScope(env, envScope);
   OH_JSVM_DestroyEnv(env);
   OH_JSVM_CloseVMScope(vm, vmScope);
@@ -192,18 +297,85 @@ void JSVMRuntime::queueMicrotask(const Function& callback) {
 }
 
 bool JSVMRuntime::drainMicrotasks(int maxMicrotasksHint) {
+  using Clock = std::chrono::steady_clock;
+  auto drainStart = Clock::now();
+  size_t count = 0;
+  auto longestTask = std::chrono::microseconds(0);
+  bool shouldYield = false;
+  SCOPE_EXIT {
+    microtaskDrainStats.count = count;
+    microtaskDrainStats.duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - drainStart);
+    microtaskDrainStats.longestTask = longestTask;
+    microtaskDrainStats.remaining = microtaskQueue_.size();
+  };
+
   while (maxMicrotasksHint && !microtaskQueue_.empty()) {
+    auto taskStart = Clock::now();
+    if (microtaskTimeBudget.count() > 0 && count > 0 &&
+        taskStart - drainStart >= microtaskTimeBudget) {
+      shouldYield = true;
+      break;
+    }
     Function callback = std::move(microtaskQueue_.front());
 
     microtaskQueue_.pop_front();
     maxMicrotasksHint--;
 
     callback.call(*this);
+    count++;
+    longestTask = std::max(
+        longestTask,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - taskStart));
   }
 
+  if (shouldYield) {
+    // RuntimeScheduler retries drainMicrotasks right away while it returns
+    // false, so the remaining microtasks are continued by a scheduler task
+    microtaskDrainStats.yieldedDrainsCount++;
+    scheduleMicrotaskDrain();
+    return true;
+  }
   return microtaskQueue_.empty();
 }
 
+void JSVMRuntime::scheduleMicrotaskDrain() {
+  if (isMicrotaskDrainScheduled) {
+    return;
+  }
+  // installed by RuntimeSchedulerBinding
+  auto runtimeScheduler = global().getProperty(*this, "nativeRuntimeScheduler");
+  if (!runtimeScheduler.isObject()) {
+    // the remaining microtasks run at the next microtask checkpoint
+    return;
+  }
+  isMicrotaskDrainScheduled = true;
+  // The RuntimeScheduler performs a microtask checkpoint after every task, so
+  // an empty task is enough to continue the drain. Errors thrown by the
+  // remaining microtasks are then reported like any other task error.
+  auto continuation = Function::createFromHostFunction(
+      *this,
+      PropNameID::forAscii(*this, "continueMicrotaskDrain"),
+      0,
+      [this](Runtime&, const Value&, const Value*, size_t) {
+        isMicrotaskDrainScheduled = false;
+        return Value::undefined();
+      });
+  runtimeScheduler.getObject(*this)
+      .getPropertyAsFunction(*this, "unstable_scheduleCallback")
+      .call(*this, NORMAL_SCHEDULER_PRIORITY, std::move(continuation));
+}
+
+void JSVMRuntime::setMicrotaskTimeBudget(std::chrono::microseconds budget) {
+  microtaskTimeBudget = budget;
+}
+
+JSVMRuntime::MicrotaskDrainStats JSVMRuntime::getMicrotaskDrainStats() const {
+  return microtaskDrainStats;
+}
+
 // TODO: optimize
 Object JSVMRuntime::global() {
   DFX();
@@ -219,10 +391,29 @@ std::string JSVMRuntime::description() {
   return "JSVM Runtime";
 }
 
+Instrumentation& JSVMRuntime::instrumentation() {
+  return *jsvmInstrumentation;
+}
+
+void JSVMRuntime::trimCaches() {
+  clearInternedPropNames();
+  if (pointerValueReleaseQueue != nullptr) {
+    pointerValueReleaseQueue->drain();
+  }
+}
+
 bool JSVMRuntime::isInspectable() {
   return false;
 }
 
+JSVMRuntime::PointerValueStats JSVMRuntime::getPointerValueStats() const {
+  return {
+      .liveRefs = JSVMPointerValue::liveCount.load(std::memory_order_relaxed),
+      .pendingReleases = pointerValueReleaseQueue
+          ? pointerValueReleaseQueue->getPendingCount()
+          : 0};
+}
+
 Runtime::PointerValue* JSVMRuntime::cloneSymbol(
     const Runtime::PointerValue* pv) {
   DFX();
@@ -257,25 +448,60 @@ PropNameID JSVMRuntime::createPropNameIDFromAscii(
     const char* str,
     size_t length) {
   DFX();
-  JSVMUtil::HandleScopeWrapper scope(env);
-
-  JSVM_Value value = nullptr;
-  OH_JSVM_CreateStringLatin1(env, str, length, &value);
-  return JSVMConverter::make<PropNameID>(env, value);
+  return createPropNameIDFromBytes(std::string_view(str, length), true);
 }
 
 PropNameID JSVMRuntime::createPropNameIDFromUtf8(
     const uint8_t* utf8,
     size_t length) {
   DFX();
-  JSVMUtil::HandleScopeWrapper scope(env);
+  return createPropNameIDFromBytes(
+      std::string_view(reinterpret_cast<const char*>(utf8), length), false);
+}
+
+PropNameID JSVMRuntime::createPropNameIDFromBytes(
+    std::string_view bytes,
+    bool isAscii) {
+  if (bytes.size() <= MAX_INTERNED_PROP_NAME_LENGTH) {
+    // ASCII is a subset of UTF-8, so both share the same table
+    auto it = internedPropNames.find(bytes);
+    if (it != internedPropNames.end()) {
+      internedPropNameHits++;
+      return make<PropNameID>(new JSVMPointerValue(it->second));
+    }
+    internedPropNameMisses++;
+  }
 
+  JSVMUtil::HandleScopeWrapper scope(env);
   JSVM_Value value = nullptr;
-  OH_JSVM_CreateStringUtf8(
-      env, reinterpret_cast<const char*>(utf8), length, &value);
+  if (isAscii) {
+    OH_JSVM_CreateStringLatin1(env, bytes.data(), bytes.size(), &value);
+  } else {
+    OH_JSVM_CreateStringUtf8(env, bytes.data(), bytes.size(), &value);
+  }
+  if (bytes.size() <= MAX_INTERNED_PROP_NAME_LENGTH &&
+      internedPropNames.size() < MAX_INTERNED_PROP_NAMES && value != nullptr) {
+    auto internedName = new JSVMPointerValue(env, value);
+    internedPropNames.emplace(std::string(bytes), internedName);
+    return make<PropNameID>(new JSVMPointerValue(internedName));
+  }
   return JSVMConverter::make<PropNameID>(env, value);
 }
 
+void JSVMRuntime::clearInternedPropNames() {
+  for (auto& [name, pointerValue] : internedPropNames) {
+    pointerValue->release();
+  }
+  internedPropNames.clear();
+}
+
+JSVMRuntime::PropNameInternStats JSVMRuntime::getPropNameInternStats() const {
+  return {
+      .size = internedPropNames.size(),
+      .hits = internedPropNameHits,
+      .misses = internedPropNameMisses};
+}
+
 PropNameID JSVMRuntime::createPropNameIDFromString(const String& str) {
   DFX();
   JSVMUtil::HandleScopeWrapper scope(env);
@@ -8,11 +8,16 @@
 #ifndef JSVMRUNTIME_H
 #define JSVMRUNTIME_H
 #include <cxxreact/MessageQueueThread.h>
+#include <atomic>
+#include <chrono>
 #include <deque>
+#include <string_view>
 #include <unordered_map>
+#include "JSVMInstrumentation.h"
 #include "JSVMUtil.h"
 #include "ark_runtime/jsvm.h"
 #include "common.h"
+#include "folly/container/F14Map.h"
 #include "folly/dynamic.h"
 
 namespace jsvm {
@@ -21,6 +26,35 @@ class JSVMRuntime;
 class JSVMPointerValue;
 class JSVMConverter;
 
+/**
+ * Releases JSVMPointerValues that were destroyed off the JS thread.
+ * Producers push onto a lock-free intrusive stack. Only the push that finds
+ * the queue empty schedules a drain task, so the JS thread releases a whole
+ * batch of values per task instead of running one task per value.
+ */
+class JSVMDeferredReleaseQueue
+    : public std::enable_shared_from_this<JSVMDeferredReleaseQueue> {
+ public:
+  explicit JSVMDeferredReleaseQueue(
+      std::shared_ptr<facebook::react::MessageQueueThread> jsQueue)
+      : jsQueue(std::move(jsQueue)) {}
+
+  // @thread: any
+  void push(JSVMPointerValue* pointerValue);
+
+  // @thread: JS
+  void drain();
+
+  size_t getPendingCount() const {
+    return pendingCount.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::shared_ptr<facebook::react::MessageQueueThread> jsQueue;
+  std::atomic<JSVMPointerValue*> head{nullptr};
+  std::atomic<size_t> pendingCount{0};
+};
+
 class JSVMRuntime : public Runtime {
  public:
   explicit JSVMRuntime(folly::dynamic initOptions);
@@ -43,12 +77,54 @@ class JSVMRuntime : public Runtime {
   void queueMicrotask(const Function& callback);
   bool drainMicrotasks(int maxMicrotasksHint = -1);
 
+  /**
+   * Limits how long a single drainMicrotasks call may run host microtasks.
+   * Once the budget is spent, the drain reports the queue as done and the
+   * remaining microtasks are drained after a task scheduled on the
+   * RuntimeScheduler, so pending events and timers can run in between.
+   * At least one microtask runs per drain. A zero budget (the default)
+   * drains the whole queue at once.
+   */
+  void setMicrotaskTimeBudget(std::chrono::microseconds budget);
+
+  struct MicrotaskDrainStats {
+    // microtasks run by the most recent drain
+    size_t count;
+    std::chrono::microseconds duration;
+    std::chrono::microseconds longestTask;
+    // microtasks left in the queue when the most recent drain stopped
+    size_t remaining;
+    // drains stopped early because they ran out of time budget
+    uint64_t yieldedDrainsCount;
+  };
+
+  MicrotaskDrainStats getMicrotaskDrainStats() const;
+
   Object global();
 
   std::string description();
 
   bool isInspectable();
 
+  Instrumentation& instrumentation() override;
+
+  struct PointerValueStats {
+    // JSVM references held by JSI values of all runtimes in the process
+    size_t liveRefs;
+    // values destroyed off the JS thread, waiting to be released
+    size_t pendingReleases;
+  };
+
+  PointerValueStats getPointerValueStats() const;
+
+  struct PropNameInternStats {
+    size_t size;
+    uint64_t hits;
+    uint64_t misses;
+  };
+
+  PropNameInternStats getPropNameInternStats() const;
+
  protected:
   Runtime::PointerValue* cloneSymbol(const Runtime::PointerValue* pv);
   Runtime::PointerValue* cloneBigInt(const Runtime::PointerValue* pv);
@@ -176,8 +252,31 @@ class JSVMRuntime : public Runtime {
   const char* cachePath = "/data/storage/el2/base/cache/js";
   static bool initialized;
   std::shared_ptr<facebook::react::MessageQueueThread> jsQueue;
+  std::shared_ptr<JSVMDeferredReleaseQueue> pointerValueReleaseQueue;
   JSVM_Ref hostObjectClass;
   std::deque<Function> microtaskQueue_;
+  std::chrono::microseconds microtaskTimeBudget{0};
+  MicrotaskDrainStats microtaskDrainStats{};
+  bool isMicrotaskDrainScheduled = false;
+  // SchedulerPriority::NormalPriority, so that pending events run first
+  static constexpr int NORMAL_SCHEDULER_PRIORITY = 3;
+  void scheduleMicrotaskDrain();
+
+  // Property names are created over and over by HostObject getters,
+  // TurboModule method lookups and dynamic conversions. Short names are
+  // interned per runtime, so a repeated name costs a reference clone instead
+  // of a new JSVM string. Once the table is full, new names aren't interned.
+  static constexpr size_t MAX_INTERNED_PROP_NAMES = 2048;
+  static constexpr size_t MAX_INTERNED_PROP_NAME_LENGTH = 64;
+  PropNameID createPropNameIDFromBytes(std::string_view bytes, bool isAscii);
+  void clearInternedPropNames();
+  folly::F14FastMap<std::string, JSVMPointerValue*> internedPropNames;
+  uint64_t internedPropNameHits = 0;
+  uint64_t internedPropNameMisses = 0;
+
+  // releases memory cached by the runtime, called on memory pressure
+  void trimCaches();
+  std::unique_ptr<JSVMInstrumentation> jsvmInstrumentation;
 
  private:
   enum { RADIX_MIN = 2, RADIX_MAX = 36 };
@@ -189,6 +288,7 @@ class JSVMPointerValue : public JSVMRuntime::PointerValue {
  public:
   JSVMPointerValue(JSVM_Env env, const JSVM_Value value, bool isWeak = false)
       : env(env), isWeak(isWeak), reference(nullptr) {
+    liveCount.fetch_add(1, std::memory_order_relaxed);
     uint32_t initialRef = 1;
     if (isWeak) {
       initialRef = 0;
@@ -198,6 +298,7 @@ class JSVMPointerValue : public JSVMRuntime::PointerValue {
 
   JSVMPointerValue(const JSVMPointerValue* pointer)
       : reference(pointer->reference), env(pointer->env), isWeak(false) {
+    liveCount.fetch_add(1, std::memory_order_relaxed);
     if (unlikely(pointer->isWeak)) {
       JSVMUtil::HandleScopeWrapper scope(env);
       JSVM_Value value = nullptr;
@@ -216,7 +317,16 @@ class JSVMPointerValue : public JSVMRuntime::PointerValue {
     return ref;
   }
 
-  ~JSVMPointerValue() {}
+  ~JSVMPointerValue() {
+    liveCount.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Pointer values are allocated for every JSI value handed out by the
+   * runtime, so their memory is recycled through a thread-local free list.
+   */
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
 
   void SetWeak() {
     OH_JSVM_ReferenceUnref(env, reference, nullptr);
@@ -253,26 +363,32 @@ class JSVMPointerValue : public JSVMRuntime::PointerValue {
     if (unlikely(!isJsThread)) {
       void* data = nullptr;
       OH_JSVM_GetInstanceData(env, &data);
-      facebook::react::MessageQueueThread* jsQueue =
-          static_cast<facebook::react::MessageQueueThread*>(data);
-      jsQueue->runOnQueue([this]() {
-        this->UnRef();
-        delete this;
-      });
-    } else {
-      UnRef();
-      delete this;
+      auto releaseQueue = static_cast<JSVMDeferredReleaseQueue*>(data);
+      if (releaseQueue != nullptr) {
+        releaseQueue->push(this);
+        return;
+      }
     }
+    release();
+  }
+
+  void release() {
+    UnRef();
+    delete this;
   }
 
   JSVM_Ref reference;
   JSVM_Env env;
   bool isWeak;
+  // intrusive link used by JSVMDeferredReleaseQueue
+  JSVMPointerValue* nextPendingRelease = nullptr;
 
  private:
   friend class JSVMRuntime;
   friend class JSVMConverter;
+  friend class JSVMDeferredReleaseQueue;
   static thread_local bool isJsThread;
+  static std::atomic<size_t> liveCount;
 };
 
 class JSVMPreparedJavaScript final : public PreparedJavaScript {
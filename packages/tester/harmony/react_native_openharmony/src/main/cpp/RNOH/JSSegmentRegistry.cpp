@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "JSSegmentRegistry.h"
+#include <cxxreact/JSExecutor.h>
+#include <glog/logging.h>
+#include <jsireact/JSIExecutor.h>
+#include "RNOH/JSBigStringHelpers.h"
+#include "RNOH/Performance/RNOHMarker.h"
+
+namespace rnoh {
+
+using namespace facebook;
+
+void JSSegmentRegistry::setCoreBundlePath(std::string coreBundlePath) {
+  auto lock = std::lock_guard(m_mtx);
+  m_coreBundlePath = std::move(coreBundlePath);
+}
+
+void JSSegmentRegistry::registerSegment(
+    uint32_t segmentId,
+    std::string segmentPath) {
+  auto lock = std::lock_guard(m_mtx);
+  m_segmentPathById.insert_or_assign(segmentId, std::move(segmentPath));
+}
+
+void JSSegmentRegistry::installJSBindings(jsi::Runtime& rt) {
+  auto nativeRequire = jsi::Function::createFromHostFunction(
+      rt,
+      jsi::PropNameID::forAscii(rt, "nativeRequire"),
+      2,
+      [self = shared_from_this()](
+          jsi::Runtime& rt,
+          jsi::Value const& /*thisValue*/,
+          jsi::Value const* args,
+          size_t count) {
+        if (count < 2 || !args[1].isNumber()) {
+          throw jsi::JSError(rt, "nativeRequire: expected a segment id");
+        }
+        // the local module id is irrelevant, evaluating the segment defines
+        // all of its modules
+        auto segmentId = static_cast<uint32_t>(args[1].asNumber());
+        // Segment 0 is the core bundle, which is loaded already. Metro asks
+        // for it whenever a module is missing from a non-segmented bundle,
+        // and then reports its own unknown module error.
+        if (segmentId == CORE_SEGMENT_ID) {
+          return jsi::Value::undefined();
+        }
+        self->evaluateSegment(rt, segmentId);
+        return jsi::Value::undefined();
+      });
+  rt.global().setProperty(rt, "nativeRequire", std::move(nativeRequire));
+}
+
+void JSSegmentRegistry::evaluateSegment(jsi::Runtime& rt, uint32_t segmentId) {
+  std::optional<std::string> segmentPath;
+  {
+    auto lock = std::lock_guard(m_mtx);
+    if (m_evaluatedSegmentIds.count(segmentId) > 0) {
+      return;
+    }
+    segmentPath = findSegmentPath(segmentId);
+  }
+  auto tag = std::to_string(segmentId);
+  if (!segmentPath.has_value()) {
+    throw jsi::JSError(rt, "Couldn't find JS segment " + tag);
+  }
+  std::unique_ptr<react::JSBigString const> script;
+  try {
+    script = JSBigStringHelpers::fromFilePath(*segmentPath);
+  } catch (std::exception const& e) {
+    throw jsi::JSError(
+        rt,
+        "Couldn't read JS segment " + tag + " from " + *segmentPath + ": " +
+            e.what());
+  }
+  if (script == nullptr || script->size() == 0) {
+    throw jsi::JSError(
+        rt, "JS segment " + tag + " at " + *segmentPath + " is empty");
+  }
+  RNOHMarker::logMarker(
+      RNOHMarker::RNOHMarkerId::REGISTER_JS_SEGMENT_START, tag.c_str());
+  rt.evaluateJavaScript(
+      std::make_shared<react::BigStringBuffer>(std::move(script)),
+      react::JSExecutor::getSyntheticBundlePath(segmentId, *segmentPath));
+  RNOHMarker::logMarker(
+      RNOHMarker::RNOHMarkerId::REGISTER_JS_SEGMENT_STOP, tag.c_str());
+  DLOG(INFO) << "Evaluated JS segment " << segmentId << " from "
+             << *segmentPath;
+  auto lock = std::lock_guard(m_mtx);
+  m_evaluatedSegmentIds.insert(segmentId);
+}
+
+std::optional<std::string> JSSegmentRegistry::findSegmentPath(
+    uint32_t segmentId) const {
+  auto it = m_segmentPathById.find(segmentId);
+  if (it != m_segmentPathById.end()) {
+    return it->second;
+  }
+  if (m_coreBundlePath.empty()) {
+    return std::nullopt;
+  }
+  return m_coreBundlePath + ".segments/" + std::to_string(segmentId) +
+      ".bundle";
+}
+
+} // namespace rnoh
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <jsi/jsi.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * Segments of a segmented bundle. The core segment is loaded like any other
+ * bundle, and the remaining segments are evaluated only when JS requires one
+ * of their modules for the first time: Metro's runtime calls
+ * `global.nativeRequire(localId, segmentId)` for modules it doesn't know yet,
+ * and the segment is evaluated synchronously during that call.
+ *
+ * A segment's path is either registered explicitly, e.g. once it's downloaded,
+ * or follows the core bundle: segment N of `/path/index.bundle` is
+ * `/path/index.bundle.segments/N.bundle`.
+ */
+class JSSegmentRegistry
+    : public std::enable_shared_from_this<JSSegmentRegistry> {
+ public:
+  using Shared = std::shared_ptr<JSSegmentRegistry>;
+
+  void setCoreBundlePath(std::string coreBundlePath);
+
+  void registerSegment(uint32_t segmentId, std::string segmentPath);
+
+  /**
+   * @thread: JS
+   */
+  void installJSBindings(facebook::jsi::Runtime& rt);
+
+  /**
+   * @thread: JS
+   * @brief Evaluates the segment, unless it was evaluated already.
+   */
+  void evaluateSegment(facebook::jsi::Runtime& rt, uint32_t segmentId);
+
+ private:
+  static constexpr uint32_t CORE_SEGMENT_ID = 0;
+
+  std::optional<std::string> findSegmentPath(uint32_t segmentId) const;
+
+  mutable std::mutex m_mtx;
+  std::string m_coreBundlePath;
+  std::unordered_map<uint32_t, std::string> m_segmentPathById;
+  std::unordered_set<uint32_t> m_evaluatedSegmentIds;
+};
+
+} // namespace rnoh
@@ -29,23 +29,6 @@ std::string_view getMutationNameFromType(
   }
 }
 
-std::optional<facebook::react::SurfaceId> findSurfaceIdForComponentInstance(
-    ComponentInstance::Shared componentInstance) {
-  auto parentInstance = componentInstance->getParent().lock();
-  while (parentInstance != nullptr) {
-    componentInstance = std::move(parentInstance);
-    parentInstance = componentInstance->getParent().lock();
-  }
-  auto rootComponentTag = componentInstance->getTag();
-
-  // Fabric reserves numbers equal 1 mod 10 for SurfaceIds
-  if (rootComponentTag % 10 == 1) {
-    return static_cast<facebook::react::SurfaceId>(rootComponentTag);
-  }
-
-  return std::nullopt;
-}
-
 void MountingManagerCAPI::willMount(MutationList const& /*mutations*/) {}
 
 void MountingManagerCAPI::doMount(MutationList const& mutations) {
@@ -57,8 +40,7 @@ void MountingManagerCAPI::didMount(MutationList const& mutations) {
   facebook::react::SystraceSection s(
       ("#RNOH::MountingManager::didMount " + std::to_string(mutations.size()))
           .c_str());
-  if (!m_featureFlagRegistry->isFeatureFlagOn(
-          "PARTIAL_SYNC_OF_DESCRIPTOR_REGISTRY")) {
+  if (!m_partialSyncOfDescriptorRegistryFlag.isOn()) {
     m_arkTSMountingManager->didMount(mutations);
   } else {
     m_arkTSMountingManager->didMount(getArkTSMutations(mutations));
@@ -121,15 +103,15 @@ void MountingManagerCAPI::updateView(
     return;
   }
 
-  auto surfaceId = findSurfaceIdForComponentInstance(componentInstance);
+  auto surfaceId = componentInstance->getSurfaceId();
   if (!surfaceId.has_value()) {
     return;
   }
 
-  std::unordered_set<std::string> propKeys =
-      componentInstance->getIgnoredPropKeys();
+  // props set here must not be overwritten by the next commit
+  auto propKeys = componentInstance->getIgnoredPropKeys();
   for (const auto& key : props.keys()) {
-    propKeys.insert(key.getString());
+    propKeys.insert(internPropKey(key.getString()));
   }
 
   auto oldProps = componentInstance->getProps();
@@ -186,6 +168,7 @@ void MountingManagerCAPI::handleMutation(Mutation const& mutation) {
         return;
       }
       m_componentInstanceRegistry->insert(componentInstance);
+      componentInstance->setSurfaceId(newChild.surfaceId);
       this->updateComponentWithShadowView(componentInstance, newChild);
       break;
     }
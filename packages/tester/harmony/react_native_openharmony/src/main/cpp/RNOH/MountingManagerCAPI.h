@@ -36,6 +36,9 @@ class MountingManagerCAPI final : public MountingManager {
         m_componentInstanceProvider(std::move(componentInstanceProvider)),
         m_arkTSMountingManager(std::move(arkTSMountingManager)),
         m_featureFlagRegistry(std::move(featureFlagRegistry)),
+        m_partialSyncOfDescriptorRegistryFlag(
+            m_featureFlagRegistry->getFeatureFlag(
+                "PARTIAL_SYNC_OF_DESCRIPTOR_REGISTRY")),
         m_arkTSChannel(std::move(arkTSChannel)){};
 
   void willMount(MutationList const& mutations) override;
@@ -82,6 +85,7 @@ class MountingManagerCAPI final : public MountingManager {
   facebook::react::ContextContainer::Shared m_contextContainer;
   MountingManager::Shared m_arkTSMountingManager;
   FeatureFlagRegistry::Shared m_featureFlagRegistry;
+  FeatureFlagRegistry::FeatureFlag m_partialSyncOfDescriptorRegistryFlag;
   std::unordered_set<std::string> m_cApiComponentNames;
   std::unordered_set<std::string> m_arkTSComponentNames;
   ArkTSChannel::Shared m_arkTSChannel;
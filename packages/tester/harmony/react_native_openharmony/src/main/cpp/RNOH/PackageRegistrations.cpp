@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "PackageRegistrations.h"
+#include <glog/logging.h>
+#include <mutex>
+#include <optional>
+
+namespace rnoh {
+
+namespace {
+class PackageToComponentInstanceFactoryDelegateAdapter
+    : public ComponentInstanceFactoryDelegate {
+  Package::Shared m_package;
+
+ public:
+  PackageToComponentInstanceFactoryDelegateAdapter(Package::Shared package)
+      : m_package(std::move(package)) {}
+
+  ComponentInstance::Shared create(ComponentInstance::Context ctx) override {
+    return m_package->createComponentInstance(std::move(ctx));
+  };
+};
+
+template <typename T>
+void append(std::vector<T>& target, std::vector<T> const& source) {
+  target.insert(target.end(), source.begin(), source.end());
+}
+} // namespace
+
+PackageRegistrations PackageRegistrations::collect(
+    Package::Shared const& package,
+    bool shouldCollectComponentDescriptorProviders) {
+  PackageRegistrations registrations;
+  auto turboModuleFactoryDelegate = package->createTurboModuleFactoryDelegate();
+  if (turboModuleFactoryDelegate != nullptr) {
+    registrations.turboModuleFactoryDelegates.push_back(
+        std::move(turboModuleFactoryDelegate));
+  }
+  if (shouldCollectComponentDescriptorProviders) {
+    registrations.componentDescriptorProviders =
+        package->createComponentDescriptorProviders();
+  }
+  registrations.componentJSIBinderByName =
+      package->createComponentJSIBinderByName();
+  registrations.componentNapiBinderByName =
+      package->createComponentNapiBinderByName();
+  registrations.globalJSIBinders = package->createGlobalJSIBinders();
+  append(registrations.globalJSIBinders, package->createGlobalJSIBinders({}));
+  registrations.eventEmitRequestHandlers =
+      package->createEventEmitRequestHandlers();
+  auto componentInstanceFactoryDelegate =
+      package->createComponentInstanceFactoryDelegate();
+  if (componentInstanceFactoryDelegate != nullptr) {
+    registrations.componentInstanceFactoryDelegates.push_back(
+        std::move(componentInstanceFactoryDelegate));
+  }
+  registrations.componentInstanceFactoryDelegates.push_back(
+      std::make_shared<PackageToComponentInstanceFactoryDelegateAdapter>(
+          package));
+  return registrations;
+}
+
+void PackageRegistrations::merge(PackageRegistrations const& other) {
+  append(componentDescriptorProviders, other.componentDescriptorProviders);
+  append(turboModuleFactoryDelegates, other.turboModuleFactoryDelegates);
+  componentJSIBinderByName.insert(
+      other.componentJSIBinderByName.begin(),
+      other.componentJSIBinderByName.end());
+  componentNapiBinderByName.insert(
+      other.componentNapiBinderByName.begin(),
+      other.componentNapiBinderByName.end());
+  append(globalJSIBinders, other.globalJSIBinders);
+  append(eventEmitRequestHandlers, other.eventEmitRequestHandlers);
+  append(
+      componentInstanceFactoryDelegates,
+      other.componentInstanceFactoryDelegates);
+}
+
+std::vector<facebook::react::ComponentDescriptorProvider> const&
+AppComponentDescriptorProviders::get(
+    std::vector<Package::Shared> const& appPackages) {
+  static std::mutex mtx;
+  static std::optional<
+      std::vector<facebook::react::ComponentDescriptorProvider>>
+      providers;
+  auto lock = std::lock_guard(mtx);
+  if (!providers.has_value()) {
+    providers.emplace();
+    for (auto const& package : appPackages) {
+      append(*providers, package->createComponentDescriptorProviders());
+    }
+    DLOG(INFO) << "Collected " << providers->size()
+               << " component descriptor providers of "
+               << appPackages.size() << " app packages";
+  }
+  return *providers;
+}
+
+} // namespace rnoh
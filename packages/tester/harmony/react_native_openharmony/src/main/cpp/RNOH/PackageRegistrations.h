@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+#include "RNOH/Package.h"
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @thread: MAIN
+ *
+ * Everything an RN instance collects from its packages, except
+ * ArkTSMessageHandlers. Apart from the component descriptor providers, these
+ * are objects owned by the instance, so they are created for every instance.
+ */
+struct PackageRegistrations {
+  std::vector<facebook::react::ComponentDescriptorProvider>
+      componentDescriptorProviders;
+  std::vector<std::shared_ptr<TurboModuleFactoryDelegate>>
+      turboModuleFactoryDelegates;
+  ComponentJSIBinderByString componentJSIBinderByName;
+  ComponentNapiBinderByString componentNapiBinderByName;
+  GlobalJSIBinders globalJSIBinders;
+  EventEmitRequestHandlers eventEmitRequestHandlers;
+  std::vector<ComponentInstanceFactoryDelegate::Shared>
+      componentInstanceFactoryDelegates;
+
+  /**
+   * @param shouldCollectComponentDescriptorProviders false if the package's
+   * providers are taken from AppComponentDescriptorProviders
+   */
+  static PackageRegistrations collect(
+      Package::Shared const& package,
+      bool shouldCollectComponentDescriptorProviders = true);
+
+  /**
+   * @brief Appends `other`'s registrations. Binders already registered under
+   * the same name take precedence.
+   */
+  void merge(PackageRegistrations const& other);
+};
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * Component descriptor providers of the packages provided by the app. They
+ * are immutable values (name, handle, flavor and constructor) which only
+ * depend on the app, so they are collected from the packages of the first
+ * RN instance and reused by the later ones.
+ */
+class AppComponentDescriptorProviders {
+ public:
+  static std::vector<facebook::react::ComponentDescriptorProvider> const& get(
+      std::vector<Package::Shared> const& appPackages);
+};
+
+} // namespace rnoh
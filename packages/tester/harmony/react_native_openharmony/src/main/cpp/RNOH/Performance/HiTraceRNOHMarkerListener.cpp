@@ -146,6 +146,12 @@ void HiTraceRNOHMarkerListener::logMarker(
     case RNOHMarkerId::PROCESS_CORE_REACT_PACKAGE_END:
       logMarkerFinish("PROCESS_CORE_REACT_PACKAGE", tag);
       break;
+    case RNOHMarkerId::PREWARM_REACT_INSTANCE_START:
+      logMarkerStart("PREWARM_REACT_INSTANCE", tag);
+      break;
+    case RNOHMarkerId::PREWARM_REACT_INSTANCE_STOP:
+      logMarkerFinish("PREWARM_REACT_INSTANCE", tag);
+      break;
     case RNOHMarkerId::DOWNLOAD_START:
       logMarkerStart("DOWNLOAD", tag);
       break;
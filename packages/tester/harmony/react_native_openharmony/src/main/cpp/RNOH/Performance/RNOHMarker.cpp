@@ -195,6 +195,10 @@ std::string RNOHMarker::harmonyMarkerIdToString(const RNOHMarkerId markerId) {
       return "PROCESS_CORE_REACT_PACKAGE_START";
     case RNOHMarkerId::PROCESS_CORE_REACT_PACKAGE_END:
       return "PROCESS_CORE_REACT_PACKAGE_END";
+    case RNOHMarkerId::PREWARM_REACT_INSTANCE_START:
+      return "PREWARM_REACT_INSTANCE_START";
+    case RNOHMarkerId::PREWARM_REACT_INSTANCE_STOP:
+      return "PREWARM_REACT_INSTANCE_STOP";
     case RNOHMarkerId::FABRIC_COMMIT_START:
       return "FABRIC_COMMIT_START";
     case RNOHMarkerId::FABRIC_COMMIT_END:
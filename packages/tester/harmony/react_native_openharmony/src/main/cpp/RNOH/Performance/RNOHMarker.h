@@ -61,6 +61,8 @@ class RNOHMarker {
     CREATE_MODULE_END,
     PROCESS_CORE_REACT_PACKAGE_START,
     PROCESS_CORE_REACT_PACKAGE_END,
+    PREWARM_REACT_INSTANCE_START,
+    PREWARM_REACT_INSTANCE_STOP,
     // Fabric-specific constants below this line
     FABRIC_COMMIT_START,
     FABRIC_COMMIT_END,
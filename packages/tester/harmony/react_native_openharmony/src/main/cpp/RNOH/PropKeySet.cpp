@@ -0,0 +1,27 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "PropKeySet.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace rnoh {
+
+PropKeyId internPropKey(std::string const& propKey) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, PropKeyId> propKeyIdByName;
+  auto lock = std::lock_guard(mutex);
+  auto it = propKeyIdByName.find(propKey);
+  if (it != propKeyIdByName.end()) {
+    return it->second;
+  }
+  auto propKeyId = static_cast<PropKeyId>(propKeyIdByName.size());
+  propKeyIdByName.emplace(propKey, propKeyId);
+  return propKeyId;
+}
+
+} // namespace rnoh
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <folly/small_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace rnoh {
+
+/**
+ * @internal
+ */
+using PropKeyId = uint32_t;
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * Returns the process-wide id of a prop name. Ids are never released, since
+ * only a few distinct prop names are used.
+ */
+PropKeyId internPropKey(std::string const& propKey);
+
+/**
+ * @internal
+ *
+ * A small set of interned prop names, e.g. the props currently managed by
+ * Animated. Up to 8 names are stored inline, so updating the set on every
+ * animation frame doesn't allocate.
+ */
+class PropKeySet {
+ public:
+  void insert(PropKeyId propKeyId) {
+    if (!contains(propKeyId)) {
+      m_propKeyIds.push_back(propKeyId);
+    }
+  }
+
+  bool contains(PropKeyId propKeyId) const {
+    return std::find(m_propKeyIds.begin(), m_propKeyIds.end(), propKeyId) !=
+        m_propKeyIds.end();
+  }
+
+  bool empty() const {
+    return m_propKeyIds.empty();
+  }
+
+  void clear() {
+    m_propKeyIds.clear();
+  }
+
+ private:
+  folly::small_vector<PropKeyId, 8> m_propKeyIds;
+};
+
+} // namespace rnoh
@@ -68,15 +68,18 @@ void RNInstanceCAPI::synchronouslyUpdateViewOnUIThread(
     return;
   }
 
-  auto componentHandle = componentInstance->getComponentHandle();
-  auto componentDescriptor =
-      m_scheduler->findComponentDescriptorByHandle_DO_NOT_USE_THIS_IS_BROKEN(
-          componentHandle);
+  auto componentDescriptor = componentInstance->getComponentDescriptor();
   if (componentDescriptor == nullptr) {
-    LOG(ERROR)
-        << "RNInstanceCAPI::synchronouslyUpdateViewOnUIThread: could not find componentDescriptor for tag: "
-        << tag;
-    return;
+    componentDescriptor =
+        m_scheduler->findComponentDescriptorByHandle_DO_NOT_USE_THIS_IS_BROKEN(
+            componentInstance->getComponentHandle());
+    if (componentDescriptor == nullptr) {
+      LOG(ERROR)
+          << "RNInstanceCAPI::synchronouslyUpdateViewOnUIThread: could not find componentDescriptor for tag: "
+          << tag;
+      return;
+    }
+    componentInstance->setComponentDescriptor(componentDescriptor);
   }
 
   RNOHMarker::logMarker(
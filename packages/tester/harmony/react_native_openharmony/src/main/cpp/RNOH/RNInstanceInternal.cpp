@@ -79,6 +79,23 @@ void RNInstanceInternal::postMessageToArkTS(
   m_arkTSChannel->postMessage(name, payload);
 }
 
+void RNInstanceInternal::setPrewarmedJSRuntime(
+    std::shared_ptr<MessageQueueThread> jsQueue,
+    std::unique_ptr<facebook::react::JSRuntime> jsRuntime) {
+  m_jsQueue = std::move(jsQueue);
+  m_prewarmedJSRuntime = std::move(jsRuntime);
+}
+
+void RNInstanceInternal::setTurboModuleWarmSet(
+    TurboModuleWarmSet::Shared turboModuleWarmSet) {
+  m_turboModuleWarmSet = std::move(turboModuleWarmSet);
+}
+
+void RNInstanceInternal::setTextPreMeasurer(
+    TextPreMeasurer::Shared textPreMeasurer) {
+  m_textPreMeasurer = std::move(textPreMeasurer);
+}
+
 /**
  * @brief Initialize the runtime environment, scheduling, and context
  */
@@ -94,6 +111,10 @@ void RNInstanceInternal::start() {
       "RNOH::RNInstance", weak_from_this());
 
   m_turboModuleProvider = createTurboModuleProvider();
+  if (m_turboModuleWarmSet != nullptr) {
+    m_turboModuleProvider->setWarmSet(m_turboModuleWarmSet);
+    prewarmTurboModules();
+  }
   initializeScheduler(m_turboModuleProvider);
   m_reactInstance->getBufferedRuntimeExecutor()(
       [binders = m_globalJSIBinders,
@@ -117,6 +138,37 @@ void RNInstanceInternal::start() {
   textMeasurer->setTextMeasureParams(fontScale, scale);
 }
 
+/**
+ * @brief Creates the warm set's Turbo Modules with idle priority, one per
+ * task, so that they don't delay other JS work.
+ */
+void RNInstanceInternal::prewarmTurboModules() {
+  for (auto const& moduleName : m_turboModuleWarmSet->getModuleNames()) {
+    m_runtimeScheduler->scheduleTask(
+        react::SchedulerPriority::IdlePriority,
+        [weakTurboModuleProvider = std::weak_ptr(m_turboModuleProvider),
+         moduleName](jsi::Runtime& /*runtime*/) {
+          auto turboModuleProvider = weakTurboModuleProvider.lock();
+          if (turboModuleProvider == nullptr) {
+            return;
+          }
+          try {
+            turboModuleProvider->getTurboModule(moduleName);
+          } catch (std::exception const& e) {
+            // the module may be gone since the warm set was recorded
+            LOG(WARNING) << "Couldn't prewarm Turbo Module '" << moduleName
+                         << "': " << e.what();
+          }
+        });
+  }
+  m_taskExecutor->runDelayedTask(
+      TaskThread::JS,
+      [turboModuleWarmSet = m_turboModuleWarmSet] {
+        turboModuleWarmSet->finishRecording();
+      },
+      m_turboModuleWarmSet->getRemainingRecordingTime().count());
+}
+
 bool RNInstanceInternal::s_hasInitializedFeatureFlags = false;
 
 /**
@@ -127,8 +179,13 @@ void RNInstanceInternal::initialize() {
 
   // create a new event dispatcher every time RN is initialized
   m_eventDispatcher = std::make_shared<EventDispatcher>();
-  m_jsQueue = std::make_shared<MessageQueueThread>(m_taskExecutor);
-  RNOHMarker::logMarker(RNOHMarker::RNOHMarkerId::REACT_BRIDGE_LOADING_START);
+  // the tag splits pooled and cold creation times
+  auto jsRuntimeOrigin = m_prewarmedJSRuntime ? "pooled" : "cold";
+  RNOHMarker::logMarker(
+      RNOHMarker::RNOHMarkerId::REACT_BRIDGE_LOADING_START, jsRuntimeOrigin);
+  if (m_jsQueue == nullptr) {
+    m_jsQueue = std::make_shared<MessageQueueThread>(m_taskExecutor);
+  }
   auto onJSError =
       [this](jsi::Runtime& runtime, const JsErrorHandler::ParsedError& error) {
         m_taskExecutor->runSyncTask(TaskThread::MAIN, [&error, this]() {
@@ -145,7 +202,9 @@ void RNInstanceInternal::initialize() {
         LOG(ERROR) << "Error raised when executing JS: " << msg.str();
       };
 
-  auto jsRuntime = m_jsEngineProvider->createJSRuntime(m_jsQueue);
+  auto jsRuntime = m_prewarmedJSRuntime
+      ? std::move(m_prewarmedJSRuntime)
+      : m_jsEngineProvider->createJSRuntime(m_jsQueue);
   auto timerRegistry = std::make_unique<HarmonyTimerRegistry>(m_taskExecutor);
   auto rawTimerRegistry = timerRegistry.get();
   auto timerManager =
@@ -163,10 +222,14 @@ void RNInstanceInternal::initialize() {
       // runtime installer, which is run when the runtime
       // is first initialized and provides access to the runtime
       // before the JS code is executed
-      [this](facebook::jsi::Runtime& rt) { installJSBindings(rt); });
+      [this](facebook::jsi::Runtime& rt) {
+        m_jsSegmentRegistry->installJSBindings(rt);
+        installJSBindings(rt);
+      });
   timerManager->setRuntimeExecutor(
       m_reactInstance->getBufferedRuntimeExecutor());
-  RNOHMarker::logMarker(RNOHMarker::RNOHMarkerId::REACT_BRIDGE_LOADING_END);
+  RNOHMarker::logMarker(
+      RNOHMarker::RNOHMarkerId::REACT_BRIDGE_LOADING_END, jsRuntimeOrigin);
 }
 
 /**
@@ -207,6 +270,9 @@ void RNInstanceInternal::initializeScheduler(
       schedulerToolbox, m_animationDriver.get(), m_schedulerDelegate.get());
   m_schedulerDelegate->setScheduler(m_scheduler);
   turboModuleProvider->setScheduler(m_scheduler);
+  if (m_textPreMeasurer != nullptr) {
+    m_scheduler->getUIManager()->registerCommitHook(*m_textPreMeasurer);
+  }
   DLOG(INFO) << "RNInstanceInternal::initializeScheduler::end";
 }
 
@@ -274,9 +340,16 @@ void RNInstanceInternal::loadScriptFromFile(
   if (jsBundle) {
     DLOG(INFO) << "Loaded bundle from file";
   }
+  m_jsSegmentRegistry->setCoreBundlePath(fileUrl);
   this->loadScript(std::move(jsBundle), fileUrl, onFinish);
 }
 
+void RNInstanceInternal::registerSegment(
+    uint32_t segmentId,
+    std::string segmentPath) {
+  m_jsSegmentRegistry->registerSegment(segmentId, std::move(segmentPath));
+}
+
 /**
  * @brief Loads a bundle from hap resource.
  * @param rawFileUrl
@@ -377,9 +450,21 @@ void RNInstanceInternal::onMemoryLevel(size_t memoryLevel) {
   static const int memoryLevels[] = {5, 10, 15};
   facebook::react::SystraceSection s(
       "#RNOH::RNInstanceInternal::onMemoryLevel");
+  // Ark's MEMORY_LEVEL_CRITICAL
+  static constexpr size_t criticalMemoryLevel = 2;
   if (m_reactInstance) {
+    // on critical level, ReactInstance runs a GC through
+    // jsi::Instrumentation::collectGarbage, which also trims runtime caches
     m_reactInstance->handleMemoryPressureJs(memoryLevels[memoryLevel]);
   }
+  if (memoryLevel >= criticalMemoryLevel) {
+    auto textMeasurer =
+        m_contextContainer->at<std::shared_ptr<rnoh::TextMeasurer>>(
+            "textLayoutManagerDelegate");
+    if (textMeasurer) {
+      textMeasurer->clearTextStorageCache();
+    }
+  }
 }
 
 PhysicalPixels parsePhysicalPixels(const folly::dynamic& payload) {
@@ -510,6 +595,12 @@ void RNInstanceInternal::registerFont(
     std::string const& fontFamily,
     std::string const& fontFilePath) {
   m_fontRegistry->registerFont(fontFamily, fontFilePath);
+  auto textMeasurer =
+      m_contextContainer->at<std::shared_ptr<rnoh::TextMeasurer>>(
+          "textLayoutManagerDelegate");
+  if (textMeasurer) {
+    textMeasurer->invalidateMeasurements();
+  }
 }
 
 RNInstanceInternal::RNInstanceRNOHMarkerListener::RNInstanceRNOHMarkerListener(
@@ -633,6 +724,9 @@ RNInstanceInternal::RNInstanceInternal(
  * @brief The destructor of RNInstanceInternal.
  */
 RNInstanceInternal::~RNInstanceInternal() noexcept {
+  if (m_scheduler != nullptr && m_textPreMeasurer != nullptr) {
+    m_scheduler->getUIManager()->unregisterCommitHook(*m_textPreMeasurer);
+  }
   m_reactInstance->unregisterFromInspector();
 };
 
@@ -16,10 +16,12 @@
 #include "RNOH/FontRegistry.h"
 #include "RNOH/GlobalJSIBinder.h"
 #include "RNOH/InspectorHostTarget.h"
+#include "RNOH/JSSegmentRegistry.h"
 #include "RNOH/MountingManager.h"
 #include "RNOH/Performance/RNOHMarker.h"
 #include "RNOH/RNInstance.h"
 #include "RNOH/SchedulerDelegate.h"
+#include "RNOH/TextPreMeasurer.h"
 #include "RNOH/TurboModuleFactory.h"
 #include "RNOH/TurboModuleProvider.h"
 #include "RNOH/UITicker.h"
@@ -90,6 +92,25 @@ class RNInstanceInternal
   NativeResourceManager const* getNativeResourceManager() const override;
 
   TaskExecutor::Shared getTaskExecutor();
+
+  /**
+   * @brief Makes `start` use a JS runtime created ahead of time instead of
+   * creating one. `jsQueue` must run on this instance's TaskExecutor.
+   */
+  void setPrewarmedJSRuntime(
+      std::shared_ptr<MessageQueueThread> jsQueue,
+      std::unique_ptr<facebook::react::JSRuntime> jsRuntime);
+
+  /**
+   * @brief Makes `start` record Turbo Modules accessed from JS and create the
+   * warm set's modules when the JS thread is idle.
+   */
+  void setTurboModuleWarmSet(TurboModuleWarmSet::Shared turboModuleWarmSet);
+  /**
+   * @brief Makes the instance measure texts of committed shadow trees ahead
+   * of the layout. Must be called before `start`.
+   */
+  void setTextPreMeasurer(TextPreMeasurer::Shared textPreMeasurer);
   void start();
   void loadScriptFromBuffer(
       std::vector<uint8_t> bundle,
@@ -98,6 +119,12 @@ class RNInstanceInternal
   void loadScriptFromFile(
       std::string const fileURL,
       std::function<void(const std::string)> onFinish);
+  /**
+   * @brief Registers where a segment of a segmented bundle is stored. The
+   * segment is evaluated when JS requires one of its modules for the first
+   * time. See JSSegmentRegistry.
+   */
+  void registerSegment(uint32_t segmentId, std::string segmentPath);
   void loadScriptFromRawFile(
       std::string const rawFileURL,
       std::function<void(const std::string)> onFinish);
@@ -190,6 +217,7 @@ class RNInstanceInternal
 
  protected:
   void initialize();
+  void prewarmTurboModules();
   void initializeScheduler(
       std::shared_ptr<TurboModuleProvider> turboModuleProvider);
   virtual std::shared_ptr<TurboModuleProvider> createTurboModuleProvider() = 0;
@@ -212,6 +240,8 @@ class RNInstanceInternal
   MountingManager::Shared m_mountingManager;
 
   ArkTSBridge::Shared m_arkTSBridge;
+  // registered in the UIManager, so it's declared before `m_scheduler`
+  TextPreMeasurer::Shared m_textPreMeasurer = nullptr;
 
   /**
    * NOTE: Order matters. m_scheduler holds indirectly jsi::Values.
@@ -237,6 +267,10 @@ class RNInstanceInternal
   std::mutex m_unsubscribeUITickListenerMtx;
   std::function<void()> m_unsubscribeUITickListener = nullptr;
   std::shared_ptr<MessageQueueThread> m_jsQueue = nullptr;
+  std::unique_ptr<facebook::react::JSRuntime> m_prewarmedJSRuntime = nullptr;
+  TurboModuleWarmSet::Shared m_turboModuleWarmSet = nullptr;
+  JSSegmentRegistry::Shared m_jsSegmentRegistry =
+      std::make_shared<JSSegmentRegistry>();
   SharedNativeResourceManager m_nativeResourceManager;
   bool m_shouldEnableDebugger;
   std::vector<ArkTSMessageHandler::Shared> m_arkTSMessageHandlers;
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "RNInstancePool.h"
+#include <glog/logging.h>
+#include <jsireact/JSIExecutor.h>
+#include <thread>
+#include "RNOH/JSBigStringHelpers.h"
+#include "RNOH/Performance/RNOHMarker.h"
+
+namespace rnoh {
+
+namespace {
+/**
+ * The runtime must be destroyed on its JS thread. The task keeps the JS
+ * queue, and with it the TaskExecutor, alive until it runs.
+ */
+void release(RNInstancePool::PrewarmedInstance instance) {
+  auto jsQueue = instance.jsQueue;
+  jsQueue->runOnQueue(
+      [jsQueue,
+       jsRuntime = std::shared_ptr<facebook::react::JSRuntime>(
+           std::move(instance.jsRuntime))]() mutable { jsRuntime.reset(); });
+}
+} // namespace
+
+RNInstancePool::RNInstancePool(
+    napi_env mainEnv,
+    std::shared_ptr<facebook::react::JSRuntimeFactory> jsRuntimeFactory,
+    std::string preludeBundlePath,
+    JSTaskRunnerFactory createJSTaskRunner)
+    : m_mainEnv(mainEnv),
+      m_jsRuntimeFactory(std::move(jsRuntimeFactory)),
+      m_preludeBundlePath(std::move(preludeBundlePath)),
+      m_createJSTaskRunner(std::move(createJSTaskRunner)),
+      m_mainTaskRunner(
+          std::make_shared<NapiTaskRunner>("RNOH_INSTANCE_POOL", mainEnv)) {}
+
+RNInstancePool::~RNInstancePool() noexcept {
+  for (auto& instance : m_readyInstances) {
+    release(std::move(instance));
+  }
+}
+
+void RNInstancePool::resize(size_t size) {
+  size_t missingCount = 0;
+  {
+    auto lock = std::lock_guard(m_mtx);
+    m_size = size;
+    while (m_readyInstances.size() > m_size) {
+      release(std::move(m_readyInstances.back()));
+      m_readyInstances.pop_back();
+    }
+    auto count = m_readyInstances.size() + m_pendingCount;
+    missingCount = m_size > count ? m_size - count : 0;
+  }
+  for (size_t i = 0; i < missingCount; i++) {
+    prewarm();
+  }
+}
+
+std::optional<RNInstancePool::PrewarmedInstance> RNInstancePool::acquire() {
+  std::optional<PrewarmedInstance> instance;
+  {
+    auto lock = std::lock_guard(m_mtx);
+    if (m_readyInstances.empty()) {
+      return std::nullopt;
+    }
+    instance = std::move(m_readyInstances.front());
+    m_readyInstances.pop_front();
+  }
+  // refilling is kept off the path of the instance being created
+  m_mainTaskRunner->runAsyncTask([weakSelf = weak_from_this()] {
+    if (auto self = weakSelf.lock()) {
+      self->prewarm();
+    }
+  });
+  return instance;
+}
+
+size_t RNInstancePool::getReadyCount() const {
+  auto lock = std::lock_guard(m_mtx);
+  return m_readyInstances.size();
+}
+
+void RNInstancePool::prewarm() {
+  {
+    auto lock = std::lock_guard(m_mtx);
+    m_pendingCount++;
+  }
+  // only the task runners must be created on the main thread, the JS thread
+  // and the runtime are created in the background
+  auto mainTaskRunner =
+      std::make_shared<NapiTaskRunner>("RNOH_MAIN", m_mainEnv);
+  auto jsTaskRunner = m_createJSTaskRunner ? m_createJSTaskRunner() : nullptr;
+  std::thread([weakSelf = weak_from_this(),
+               jsRuntimeFactory = m_jsRuntimeFactory,
+               preludeBundlePath = m_preludeBundlePath,
+               mainTaskRunner = std::move(mainTaskRunner),
+               jsTaskRunner = std::move(jsTaskRunner)]() mutable {
+    RNOHMarker::logMarker(
+        RNOHMarker::RNOHMarkerId::PREWARM_REACT_INSTANCE_START);
+    auto taskExecutor = std::make_shared<TaskExecutor>(
+        std::move(mainTaskRunner), nullptr, std::move(jsTaskRunner));
+    auto jsQueue = std::make_shared<MessageQueueThread>(taskExecutor);
+    auto jsRuntime = jsRuntimeFactory->createJSRuntime(jsQueue);
+    if (!preludeBundlePath.empty()) {
+      jsQueue->runOnQueueSync([&] {
+        try {
+          auto prelude = std::make_shared<facebook::react::BigStringBuffer>(
+              JSBigStringHelpers::fromFilePath(preludeBundlePath));
+          jsRuntime->getRuntime().evaluateJavaScript(
+              prelude, preludeBundlePath);
+        } catch (const std::exception& e) {
+          LOG(ERROR) << "Failed to evaluate prelude bundle "
+                     << preludeBundlePath << ": " << e.what();
+        }
+      });
+    }
+    RNOHMarker::logMarker(
+        RNOHMarker::RNOHMarkerId::PREWARM_REACT_INSTANCE_STOP);
+    PrewarmedInstance instance{
+        std::move(taskExecutor), std::move(jsQueue), std::move(jsRuntime)};
+    if (auto self = weakSelf.lock()) {
+      self->onPrewarmed(std::move(instance));
+    } else {
+      release(std::move(instance));
+    }
+  }).detach();
+}
+
+void RNInstancePool::onPrewarmed(PrewarmedInstance instance) {
+  auto lock = std::lock_guard(m_mtx);
+  m_pendingCount--;
+  if (m_readyInstances.size() >= m_size) {
+    release(std::move(instance));
+    return;
+  }
+  m_readyInstances.push_back(std::move(instance));
+}
+
+} // namespace rnoh
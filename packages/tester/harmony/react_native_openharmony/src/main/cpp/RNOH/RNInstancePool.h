@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <react/runtime/JSRuntimeFactory.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include "RNOH/MessageQueueThread.h"
+#include "RNOH/TaskExecutor/NapiTaskRunner.h"
+#include "RNOH/TaskExecutor/TaskExecutor.h"
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @thread: MAIN
+ *
+ * Builds the parts of an RN instance that don't depend on its ArkTS side ahead
+ * of time: the TaskExecutor with its JS thread, the JS queue and the JS
+ * runtime, optionally with a prelude bundle already evaluated. Instances are
+ * prewarmed in the background, and `acquire` hands out only the ready ones,
+ * so instance creation never waits for the pool. Every acquired instance is
+ * replaced by a new one, once the instance that acquired it has been
+ * created.
+ */
+class RNInstancePool : public std::enable_shared_from_this<RNInstancePool> {
+ public:
+  using Shared = std::shared_ptr<RNInstancePool>;
+
+  /**
+   * Creates the JS task runner of a prewarmed instance, e.g. one running on a
+   * thread shared with other instances. Called on the main thread.
+   */
+  using JSTaskRunnerFactory =
+      std::function<std::unique_ptr<AbstractTaskRunner>()>;
+
+  struct PrewarmedInstance {
+    TaskExecutor::Shared taskExecutor;
+    std::shared_ptr<MessageQueueThread> jsQueue;
+    std::unique_ptr<facebook::react::JSRuntime> jsRuntime;
+  };
+
+  /**
+   * @param preludeBundlePath path to a plain JS bundle evaluated in every
+   * prewarmed runtime. It runs before React Native installs its bindings, so
+   * it may only rely on the JS engine's built-ins. Empty for no prelude.
+   * @param createJSTaskRunner null to give every instance a dedicated JS
+   * thread
+   */
+  RNInstancePool(
+      napi_env mainEnv,
+      std::shared_ptr<facebook::react::JSRuntimeFactory> jsRuntimeFactory,
+      std::string preludeBundlePath,
+      JSTaskRunnerFactory createJSTaskRunner = nullptr);
+
+  ~RNInstancePool() noexcept;
+
+  /**
+   * @brief Keeps `size` instances prewarmed.
+   */
+  void resize(size_t size);
+
+  /**
+   * @return a ready instance or nullopt if none finished prewarming yet
+   */
+  std::optional<PrewarmedInstance> acquire();
+
+  /**
+   * @threadSafe
+   */
+  size_t getReadyCount() const;
+
+ private:
+  void prewarm();
+  void onPrewarmed(PrewarmedInstance instance);
+
+  napi_env m_mainEnv;
+  std::shared_ptr<facebook::react::JSRuntimeFactory> m_jsRuntimeFactory;
+  std::string m_preludeBundlePath;
+  JSTaskRunnerFactory m_createJSTaskRunner;
+  // defers refills out of `acquire`
+  std::shared_ptr<NapiTaskRunner> m_mainTaskRunner;
+  mutable std::mutex m_mtx;
+  std::deque<PrewarmedInstance> m_readyInstances;
+  size_t m_pendingCount = 0;
+  size_t m_size = 0;
+};
+
+} // namespace rnoh
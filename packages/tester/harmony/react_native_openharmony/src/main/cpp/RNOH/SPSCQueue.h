@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <atomic>
+#include <optional>
+
+namespace rnoh {
+
+/**
+ * @internal
+ *
+ * Unbounded lock-free queue for one producer and one consumer. Pushing never
+ * waits for the consumer and popping never waits for the producer. Several
+ * threads may act as the consumer (or the producer), as long as they are
+ * synchronized with each other.
+ */
+template <typename T>
+class SPSCQueue {
+ public:
+  SPSCQueue() : m_head(new Node()), m_tail(m_head) {}
+
+  SPSCQueue(SPSCQueue const&) = delete;
+  SPSCQueue& operator=(SPSCQueue const&) = delete;
+
+  ~SPSCQueue() {
+    while (m_head != nullptr) {
+      auto next = m_head->next.load(std::memory_order_relaxed);
+      delete m_head;
+      m_head = next;
+    }
+  }
+
+  /**
+   * @thread: producer
+   */
+  void push(T value) {
+    auto node = new Node();
+    node->value = std::move(value);
+    m_tail->next.store(node, std::memory_order_release);
+    m_tail = node;
+  }
+
+  /**
+   * @thread: consumer
+   */
+  std::optional<T> pop() {
+    auto next = m_head->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return std::nullopt;
+    }
+    // `next` becomes the sentinel, its value is moved out
+    auto value = std::move(next->value);
+    delete m_head;
+    m_head = next;
+    return value;
+  }
+
+  /**
+   * @thread: consumer
+   */
+  bool empty() const {
+    return m_head->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  struct Node {
+    std::optional<T> value;
+    std::atomic<Node*> next{nullptr};
+  };
+
+  // sentinel node, owned by the consumer
+  Node* m_head;
+  // last node, owned by the producer
+  Node* m_tail;
+};
+
+} // namespace rnoh
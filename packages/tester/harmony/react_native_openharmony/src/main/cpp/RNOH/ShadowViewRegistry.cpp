@@ -12,10 +12,12 @@ namespace rnoh {
 void ShadowViewRegistry::setShadowView(
     facebook::react::Tag tag,
     facebook::react::ShadowView const& shadowView) {
-  m_shadowViewEntryByTag.insert_or_assign(
+  m_shadowViewEntryByTag.insertOrAssign(
       tag,
       ShadowViewEntry{
-          shadowView.eventEmitter, shadowView.state, shadowView.componentName});
+          shadowView.eventEmitter,
+          shadowView.state,
+          internComponentName(shadowView.componentName)});
 }
 
 void ShadowViewRegistry::clearShadowView(facebook::react::Tag tag) {
@@ -23,11 +25,22 @@ void ShadowViewRegistry::clearShadowView(facebook::react::Tag tag) {
 }
 
 std::string ShadowViewRegistry::getComponentName(facebook::react::Tag tag) {
-  auto it = m_shadowViewEntryByTag.find(tag);
-  if (it != m_shadowViewEntryByTag.end()) {
-    return it->second.componentName;
+  if (auto entry = m_shadowViewEntryByTag.find(tag)) {
+    return *entry->componentName;
   }
   return "";
 }
 
+std::string const* ShadowViewRegistry::internComponentName(
+    facebook::react::ComponentName componentName) {
+  auto it = m_internedComponentNameByPointer.find(componentName);
+  if (it != m_internedComponentNameByPointer.end()) {
+    return it->second;
+  }
+  auto internedName =
+      &*m_componentNames.emplace(componentName ? componentName : "").first;
+  m_internedComponentNameByPointer.emplace(componentName, internedName);
+  return internedName;
+}
+
 } // namespace rnoh
@@ -10,6 +10,8 @@
 #include <glog/logging.h>
 #include <react/renderer/mounting/ShadowView.h>
 #include <unordered_map>
+#include <unordered_set>
+#include "RNOH/TagIndexedMap.h"
 
 namespace rnoh {
 
@@ -27,19 +29,17 @@ class ShadowViewRegistry {
   template <typename TEventEmitter>
   std::shared_ptr<const TEventEmitter> getEventEmitter(
       facebook::react::Tag tag) {
-    auto it = m_shadowViewEntryByTag.find(tag);
-    if (it != m_shadowViewEntryByTag.end()) {
+    if (auto entry = m_shadowViewEntryByTag.find(tag)) {
       return std::dynamic_pointer_cast<const TEventEmitter>(
-          it->second.eventEmitter.lock());
+          entry->eventEmitter.lock());
     }
     return nullptr;
   }
 
   template <typename TState>
   std::shared_ptr<TState const> getFabricState(facebook::react::Tag tag) {
-    auto it = m_shadowViewEntryByTag.find(tag);
-    if (it != m_shadowViewEntryByTag.end()) {
-      return std::dynamic_pointer_cast<const TState>(it->second.state.lock());
+    if (auto entry = m_shadowViewEntryByTag.find(tag)) {
+      return std::dynamic_pointer_cast<const TState>(entry->state.lock());
     }
     return nullptr;
   }
@@ -53,11 +53,24 @@ class ShadowViewRegistry {
   struct ShadowViewEntry {
     WeakEventEmitter eventEmitter;
     WeakState state;
-    std::string componentName;
+    /**
+     * Points into m_componentNames.
+     */
+    std::string const* componentName;
   };
 
-  std::unordered_map<facebook::react::Tag, ShadowViewEntry>
-      m_shadowViewEntryByTag;
+  std::string const* internComponentName(
+      facebook::react::ComponentName componentName);
+
+  TagIndexedMap<ShadowViewEntry> m_shadowViewEntryByTag;
+  /**
+   * ShadowView component names are C strings owned by component descriptors,
+   * so there are only a few distinct pointers. They are resolved to interned
+   * strings by pointer, without hashing the string contents.
+   */
+  std::unordered_map<facebook::react::ComponentName, std::string const*>
+      m_internedComponentNameByPointer;
+  std::unordered_set<std::string> m_componentNames;
 };
 
 } // namespace rnoh
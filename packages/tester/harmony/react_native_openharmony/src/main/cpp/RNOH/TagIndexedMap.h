@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <type_traits>
+#include <vector>
+#if __has_include(<react/renderer/core/ReactPrimitives.h>)
+#include <react/renderer/core/ReactPrimitives.h>
+#endif
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @thread: not thread-safe, callers must synchronize access.
+ *
+ * Map from Fabric tags to values, optimized for the way React allocates tags:
+ * mostly dense, monotonically increasing, non-negative integers. Values are
+ * stored in lazily allocated fixed-size pages indexed directly by the tag, so
+ * lookups are two array accesses with no hashing. Pages are released once all
+ * their slots become empty, so memory follows the live tag range rather than
+ * the largest tag ever seen. Tags outside the dense range fall back to a hash
+ * map.
+ *
+ * Doesn't include React headers when they aren't available, so that it can be
+ * tested on the host.
+ */
+template <typename T>
+class TagIndexedMap {
+ public:
+  using Tag = int32_t;
+#if __has_include(<react/renderer/core/ReactPrimitives.h>)
+  static_assert(std::is_same_v<Tag, facebook::react::Tag>);
+#endif
+
+ private:
+
+  static constexpr size_t PAGE_SIZE_BITS = 8;
+  static constexpr size_t PAGE_SIZE = 1 << PAGE_SIZE_BITS;
+  // 2^24 tags — a page table of at most 64k pointers
+  static constexpr Tag MAX_DENSE_TAG = 1 << 24;
+
+  struct Page {
+    std::array<std::optional<T>, PAGE_SIZE> slots;
+    size_t occupiedSlotsCount = 0;
+  };
+
+ public:
+  T* find(Tag tag) {
+    if (isDense(tag)) {
+      auto slot = findSlot(tag);
+      return slot && *slot ? &**slot : nullptr;
+    }
+    auto it = m_fallbackValueByTag.find(tag);
+    return it != m_fallbackValueByTag.end() ? &it->second : nullptr;
+  }
+
+  T const* find(Tag tag) const {
+    return const_cast<TagIndexedMap*>(this)->find(tag);
+  }
+
+  bool contains(Tag tag) const {
+    return find(tag) != nullptr;
+  }
+
+  /**
+   * @return true if the value was inserted, false if it was assigned
+   */
+  bool insertOrAssign(Tag tag, T value) {
+    if (!isDense(tag)) {
+      auto [it, inserted] =
+          m_fallbackValueByTag.insert_or_assign(tag, std::move(value));
+      m_size += inserted ? 1 : 0;
+      return inserted;
+    }
+    auto& page = getOrCreatePage(tag);
+    auto& slot = page.slots[tag & (PAGE_SIZE - 1)];
+    bool inserted = !slot.has_value();
+    slot = std::move(value);
+    if (inserted) {
+      page.occupiedSlotsCount++;
+      m_size++;
+    }
+    return inserted;
+  }
+
+  /**
+   * @return the erased value, if there was one
+   */
+  std::optional<T> erase(Tag tag) {
+    if (!isDense(tag)) {
+      auto it = m_fallbackValueByTag.find(tag);
+      if (it == m_fallbackValueByTag.end()) {
+        return std::nullopt;
+      }
+      std::optional<T> erasedValue = std::move(it->second);
+      m_fallbackValueByTag.erase(it);
+      m_size--;
+      return erasedValue;
+    }
+    auto pageIndex = static_cast<size_t>(tag) >> PAGE_SIZE_BITS;
+    auto slot = findSlot(tag);
+    if (slot == nullptr || !slot->has_value()) {
+      return std::nullopt;
+    }
+    std::optional<T> erasedValue = std::move(*slot);
+    slot->reset();
+    m_size--;
+    auto& page = m_pages[pageIndex];
+    if (--page->occupiedSlotsCount == 0) {
+      page.reset();
+    }
+    return erasedValue;
+  }
+
+  size_t size() const {
+    return m_size;
+  }
+
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  void clear() {
+    m_pages.clear();
+    m_fallbackValueByTag.clear();
+    m_size = 0;
+  }
+
+  template <typename F>
+  void forEach(F&& fn) const {
+    for (size_t pageIndex = 0; pageIndex < m_pages.size(); pageIndex++) {
+      auto const& page = m_pages[pageIndex];
+      if (page == nullptr) {
+        continue;
+      }
+      for (size_t slotIndex = 0; slotIndex < PAGE_SIZE; slotIndex++) {
+        auto const& slot = page->slots[slotIndex];
+        if (slot) {
+          fn(static_cast<Tag>((pageIndex << PAGE_SIZE_BITS) | slotIndex),
+             *slot);
+        }
+      }
+    }
+    for (auto const& [tag, value] : m_fallbackValueByTag) {
+      fn(tag, value);
+    }
+  }
+
+ private:
+  static bool isDense(Tag tag) {
+    return tag >= 0 && tag < MAX_DENSE_TAG;
+  }
+
+  std::optional<T>* findSlot(Tag tag) {
+    if (!isDense(tag)) {
+      return nullptr;
+    }
+    auto pageIndex = static_cast<size_t>(tag) >> PAGE_SIZE_BITS;
+    if (pageIndex >= m_pages.size() || m_pages[pageIndex] == nullptr) {
+      return nullptr;
+    }
+    return &m_pages[pageIndex]->slots[tag & (PAGE_SIZE - 1)];
+  }
+
+  Page& getOrCreatePage(Tag tag) {
+    auto pageIndex = static_cast<size_t>(tag) >> PAGE_SIZE_BITS;
+    if (pageIndex >= m_pages.size()) {
+      m_pages.resize(pageIndex + 1);
+    }
+    auto& page = m_pages[pageIndex];
+    if (page == nullptr) {
+      page = std::make_unique<Page>();
+    }
+    return *page;
+  }
+
+  std::vector<std::unique_ptr<Page>> m_pages;
+  std::unordered_map<Tag, T> m_fallbackValueByTag;
+  size_t m_size = 0;
+};
+
+} // namespace rnoh
@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "SharedThreadTaskRunner.h"
+#include <glog/logging.h>
+#include <condition_variable>
+
+namespace rnoh {
+
+SharedTaskThread::SharedTaskThread(std::string name)
+    : m_threadTaskRunner(std::make_unique<ThreadTaskRunner>(std::move(name))) {}
+
+std::unique_ptr<AbstractTaskRunner> SharedTaskThread::createTaskRunner() {
+  {
+    auto lock = std::lock_guard(m_mtx);
+    m_taskRunnersCount++;
+    DLOG(INFO) << m_taskRunnersCount << " task runners share a thread";
+  }
+  return std::make_unique<SharedThreadTaskRunner>(
+      shared_from_this(), std::make_shared<TaskQueue>());
+}
+
+size_t SharedTaskThread::getTaskRunnersCount() const {
+  auto lock = std::lock_guard(m_mtx);
+  return m_taskRunnersCount;
+}
+
+void SharedTaskThread::enqueue(
+    std::shared_ptr<TaskQueue> const& queue,
+    AbstractTaskRunner::Task&& task) {
+  auto lock = std::lock_guard(m_mtx);
+  if (queue->isClosed) {
+    return;
+  }
+  queue->tasks.push_back(std::move(task));
+  if (!queue->isScheduled) {
+    queue->isScheduled = true;
+    m_scheduledQueues.push_back(queue);
+  }
+  postRunNextTaskIfNeeded();
+}
+
+void SharedTaskThread::enqueueSync(
+    std::shared_ptr<TaskQueue> const& queue,
+    AbstractTaskRunner::Task&& task) {
+  auto lock = std::lock_guard(m_mtx);
+  m_syncTasks.push_back({std::move(task), queue});
+  postRunNextTaskIfNeeded();
+}
+
+AbstractTaskRunner::DelayedTaskId SharedTaskThread::enqueueDelayed(
+    std::shared_ptr<TaskQueue> const& queue,
+    AbstractTaskRunner::Task&& task,
+    uint64_t delayMs,
+    uint64_t repeatMs) {
+  auto lock = std::lock_guard(m_mtx);
+  auto taskId = queue->nextDelayedTaskId++;
+  // the timer only moves the task to the queue, so delayed tasks are subject
+  // to the same round-robin as other tasks
+  auto sharedTask = std::make_shared<AbstractTaskRunner::Task>(std::move(task));
+  // the lock is held while scheduling the timer, so the timer can't forget
+  // the task id before it's remembered
+  auto threadTaskId = m_threadTaskRunner->runDelayedTask(
+      [weakSelf = weak_from_this(),
+       weakQueue = std::weak_ptr(queue),
+       taskId,
+       isRepeated = repeatMs > 0,
+       sharedTask] {
+        auto self = weakSelf.lock();
+        auto queue = weakQueue.lock();
+        if (self == nullptr || queue == nullptr) {
+          return;
+        }
+        if (!isRepeated) {
+          auto lock = std::lock_guard(self->m_mtx);
+          queue->threadDelayedTaskIdById.erase(taskId);
+        }
+        self->enqueue(queue, [sharedTask] { (*sharedTask)(); });
+      },
+      delayMs,
+      repeatMs);
+  queue->threadDelayedTaskIdById.emplace(taskId, threadTaskId);
+  return taskId;
+}
+
+void SharedTaskThread::cancelDelayed(
+    std::shared_ptr<TaskQueue> const& queue,
+    AbstractTaskRunner::DelayedTaskId taskId) {
+  auto lock = std::lock_guard(m_mtx);
+  auto it = queue->threadDelayedTaskIdById.find(taskId);
+  if (it == queue->threadDelayedTaskIdById.end()) {
+    return;
+  }
+  m_threadTaskRunner->cancelDelayedTask(it->second);
+  queue->threadDelayedTaskIdById.erase(it);
+}
+
+void SharedTaskThread::close(std::shared_ptr<TaskQueue> const& queue) {
+  std::deque<AbstractTaskRunner::Task> droppedTasks;
+  {
+    auto lock = std::lock_guard(m_mtx);
+    queue->isClosed = true;
+    std::swap(droppedTasks, queue->tasks);
+    for (auto [taskId, threadTaskId] : queue->threadDelayedTaskIdById) {
+      m_threadTaskRunner->cancelDelayedTask(threadTaskId);
+    }
+    queue->threadDelayedTaskIdById.clear();
+    m_taskRunnersCount--;
+  }
+  // tasks may own objects which must not be destroyed under the lock
+  droppedTasks.clear();
+}
+
+void SharedTaskThread::runNextTask() {
+  AbstractTaskRunner::Task task;
+  AbstractTaskRunner::ExceptionHandler exceptionHandler;
+  {
+    auto lock = std::lock_guard(m_mtx);
+    m_isRunNextTaskPosted = false;
+    if (!m_syncTasks.empty()) {
+      task = std::move(m_syncTasks.front().task);
+      exceptionHandler = m_syncTasks.front().queue->exceptionHandler;
+      m_syncTasks.pop_front();
+    }
+    while (!m_scheduledQueues.empty() && !task) {
+      auto queue = std::move(m_scheduledQueues.front());
+      m_scheduledQueues.pop_front();
+      if (queue->tasks.empty()) {
+        // the queue was closed after being scheduled
+        queue->isScheduled = false;
+        continue;
+      }
+      task = std::move(queue->tasks.front());
+      queue->tasks.pop_front();
+      exceptionHandler = queue->exceptionHandler;
+      if (queue->tasks.empty()) {
+        queue->isScheduled = false;
+      } else {
+        m_scheduledQueues.push_back(std::move(queue));
+      }
+    }
+    // posted before running the task, so timers and sync tasks of the event
+    // loop interleave with queued tasks
+    postRunNextTaskIfNeeded();
+  }
+  if (!task) {
+    return;
+  }
+  try {
+    task();
+  } catch (...) {
+    exceptionHandler(std::current_exception());
+  }
+}
+
+void SharedTaskThread::postRunNextTaskIfNeeded() {
+  if ((m_syncTasks.empty() && m_scheduledQueues.empty()) ||
+      m_isRunNextTaskPosted) {
+    return;
+  }
+  m_isRunNextTaskPosted = true;
+  m_threadTaskRunner->runAsyncTask([weakSelf = weak_from_this()] {
+    if (auto self = weakSelf.lock()) {
+      self->runNextTask();
+    }
+  });
+}
+
+SharedThreadTaskRunner::SharedThreadTaskRunner(
+    SharedTaskThread::Shared sharedTaskThread,
+    std::shared_ptr<SharedTaskThread::TaskQueue> queue)
+    : m_sharedTaskThread(std::move(sharedTaskThread)),
+      m_queue(std::move(queue)) {}
+
+SharedThreadTaskRunner::~SharedThreadTaskRunner() {
+  m_sharedTaskThread->close(m_queue);
+}
+
+void SharedThreadTaskRunner::runAsyncTask(Task&& task) {
+  m_sharedTaskThread->enqueue(m_queue, std::move(task));
+}
+
+void SharedThreadTaskRunner::runSyncTask(Task&& task) {
+  if (isOnCurrentThread()) {
+    task();
+    return;
+  }
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool isDone = false;
+  // the caller is blocked, so the task doesn't wait for its turn behind the
+  // queues of other task runners
+  m_sharedTaskThread->enqueueSync(m_queue, [&] {
+    // the waiting thread is notified even if the task throws
+    auto notify = [&] {
+      auto lock = std::lock_guard(mtx);
+      isDone = true;
+      cv.notify_one();
+    };
+    try {
+      task();
+    } catch (...) {
+      notify();
+      throw;
+    }
+    notify();
+  });
+  auto lock = std::unique_lock(mtx);
+  cv.wait(lock, [&] { return isDone; });
+}
+
+auto SharedThreadTaskRunner::runDelayedTask(
+    Task&& task,
+    uint64_t delayMs,
+    uint64_t repeatMs) -> DelayedTaskId {
+  return m_sharedTaskThread->enqueueDelayed(
+      m_queue, std::move(task), delayMs, repeatMs);
+}
+
+void SharedThreadTaskRunner::cancelDelayedTask(DelayedTaskId taskId) {
+  m_sharedTaskThread->cancelDelayed(m_queue, taskId);
+}
+
+bool SharedThreadTaskRunner::isOnCurrentThread() const {
+  return m_sharedTaskThread->m_threadTaskRunner->isOnCurrentThread();
+}
+
+void SharedThreadTaskRunner::setExceptionHandler(ExceptionHandler handler) {
+  auto lock = std::lock_guard(m_sharedTaskThread->m_mtx);
+  m_queue->exceptionHandler = std::move(handler);
+}
+
+} // namespace rnoh
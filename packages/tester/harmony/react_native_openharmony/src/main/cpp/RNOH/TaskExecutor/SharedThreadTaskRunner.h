@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "AbstractTaskRunner.h"
+#include "DefaultExceptionHandler.h"
+#include "ThreadTaskRunner.h"
+
+namespace rnoh {
+
+class SharedThreadTaskRunner;
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * A single event loop thread shared by several task runners, e.g. the JS
+ * task runners of lightweight RN instances, so that they don't cost a thread
+ * each. Every task runner has its own queue and the thread serves the queues
+ * round-robin, one task at a time, so a busy task runner can't starve the
+ * others. Sync tasks, whose callers are blocked, are served before any queued
+ * task. Tasks of different task runners never run concurrently.
+ */
+class SharedTaskThread : public std::enable_shared_from_this<SharedTaskThread> {
+ public:
+  using Shared = std::shared_ptr<SharedTaskThread>;
+
+  explicit SharedTaskThread(std::string name);
+
+  std::unique_ptr<AbstractTaskRunner> createTaskRunner();
+
+  size_t getTaskRunnersCount() const;
+
+ private:
+  friend class SharedThreadTaskRunner;
+
+  struct TaskQueue {
+    std::deque<AbstractTaskRunner::Task> tasks;
+    AbstractTaskRunner::ExceptionHandler exceptionHandler =
+        defaultExceptionHandler;
+    bool isScheduled = false;
+    bool isClosed = false;
+    AbstractTaskRunner::DelayedTaskId nextDelayedTaskId = 0;
+    std::unordered_map<
+        AbstractTaskRunner::DelayedTaskId,
+        AbstractTaskRunner::DelayedTaskId>
+        threadDelayedTaskIdById;
+  };
+
+  void enqueue(
+      std::shared_ptr<TaskQueue> const& queue,
+      AbstractTaskRunner::Task&& task);
+  void enqueueSync(
+      std::shared_ptr<TaskQueue> const& queue,
+      AbstractTaskRunner::Task&& task);
+  AbstractTaskRunner::DelayedTaskId enqueueDelayed(
+      std::shared_ptr<TaskQueue> const& queue,
+      AbstractTaskRunner::Task&& task,
+      uint64_t delayMs,
+      uint64_t repeatMs);
+  void cancelDelayed(
+      std::shared_ptr<TaskQueue> const& queue,
+      AbstractTaskRunner::DelayedTaskId taskId);
+  void close(std::shared_ptr<TaskQueue> const& queue);
+  void runNextTask();
+  void postRunNextTaskIfNeeded();
+
+  std::unique_ptr<ThreadTaskRunner> m_threadTaskRunner;
+  mutable std::mutex m_mtx;
+  struct SyncTask {
+    AbstractTaskRunner::Task task;
+    std::shared_ptr<TaskQueue> queue;
+  };
+
+  std::deque<SyncTask> m_syncTasks;
+  std::deque<std::shared_ptr<TaskQueue>> m_scheduledQueues;
+  bool m_isRunNextTaskPosted = false;
+  size_t m_taskRunnersCount = 0;
+};
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * A task runner with its own queue on a SharedTaskThread.
+ */
+class SharedThreadTaskRunner : public AbstractTaskRunner {
+ public:
+  SharedThreadTaskRunner(
+      SharedTaskThread::Shared sharedTaskThread,
+      std::shared_ptr<SharedTaskThread::TaskQueue> queue);
+  ~SharedThreadTaskRunner() override;
+
+  void runAsyncTask(Task&& task) override;
+  void runSyncTask(Task&& task) override;
+  DelayedTaskId
+  runDelayedTask(Task&& task, uint64_t delayMs, uint64_t repeatMs = 0) override;
+  void cancelDelayedTask(DelayedTaskId taskId) override;
+
+  bool isOnCurrentThread() const override;
+  void setExceptionHandler(ExceptionHandler handler) override;
+
+ private:
+  SharedTaskThread::Shared m_sharedTaskThread;
+  std::shared_ptr<SharedTaskThread::TaskQueue> m_queue;
+};
+
+} // namespace rnoh
@@ -18,12 +18,23 @@ namespace rnoh {
 
 TaskExecutor::TaskExecutor(
     napi_env mainEnv,
-    std::unique_ptr<AbstractTaskRunner> workerTaskRunner) {
-  auto mainTaskRunner = std::make_shared<NapiTaskRunner>("RNOH_MAIN", mainEnv);
-  auto jsTaskRunner = std::make_shared<ThreadTaskRunner>("RNOH_JS");
+    std::unique_ptr<AbstractTaskRunner> workerTaskRunner,
+    std::unique_ptr<AbstractTaskRunner> jsTaskRunner)
+    : TaskExecutor(
+          std::make_shared<NapiTaskRunner>("RNOH_MAIN", mainEnv),
+          std::move(workerTaskRunner),
+          std::move(jsTaskRunner)) {}
+
+TaskExecutor::TaskExecutor(
+    AbstractTaskRunner::Shared mainTaskRunner,
+    std::unique_ptr<AbstractTaskRunner> workerTaskRunner,
+    std::unique_ptr<AbstractTaskRunner> jsTaskRunner) {
+  if (jsTaskRunner == nullptr) {
+    jsTaskRunner = std::make_unique<ThreadTaskRunner>("RNOH_JS");
+  }
   m_taskRunners = {
       mainTaskRunner,
-      jsTaskRunner,
+      std::move(jsTaskRunner),
       nullptr, // backgroundTaskRunner
       std::move(workerTaskRunner)};
   this->runTask(TaskThread::JS, [this]() {
@@ -129,6 +140,12 @@ void TaskExecutor::setExceptionHandler(ExceptionHandler handler) {
   }
 }
 
+void TaskExecutor::setWorkerTaskRunner(
+    std::unique_ptr<AbstractTaskRunner> taskRunner) {
+  RNOH_ASSERT(m_taskRunners[TaskThread::WORKER] == nullptr);
+  m_taskRunners[TaskThread::WORKER] = std::move(taskRunner);
+}
+
 AbstractTaskRunner::Shared TaskExecutor::getTaskRunner(
     TaskThread taskThread) const {
   const auto& runner = m_taskRunners[taskThread];
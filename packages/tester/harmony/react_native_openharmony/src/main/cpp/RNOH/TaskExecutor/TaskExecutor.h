@@ -52,9 +52,24 @@ class TaskExecutor {
     friend class TaskExecutor;
   };
 
+  /**
+   * @param jsTaskRunner runs the JS thread's tasks, e.g. on a thread shared
+   * with other instances. A dedicated JS thread is created if it's null.
+   */
   TaskExecutor(
       napi_env mainEnv,
-      std::unique_ptr<AbstractTaskRunner> workerTaskRunner);
+      std::unique_ptr<AbstractTaskRunner> workerTaskRunner,
+      std::unique_ptr<AbstractTaskRunner> jsTaskRunner = nullptr);
+
+  /**
+   * @param mainTaskRunner runs the main thread's tasks. It has to be created
+   * on the main thread, but the executor itself can then be created on any
+   * thread, e.g. by RNInstancePool.
+   */
+  TaskExecutor(
+      AbstractTaskRunner::Shared mainTaskRunner,
+      std::unique_ptr<AbstractTaskRunner> workerTaskRunner,
+      std::unique_ptr<AbstractTaskRunner> jsTaskRunner = nullptr);
   ~TaskExecutor() noexcept;
 
   void runTask(TaskThread thread, Task&& task);
@@ -72,6 +87,13 @@ class TaskExecutor {
 
   void setExceptionHandler(ExceptionHandler handler);
 
+  /**
+   * @brief Attaches the worker task runner to an executor created without
+   * one, e.g. by RNInstancePool. Must be called before the executor is shared
+   * with an RN instance.
+   */
+  void setWorkerTaskRunner(std::unique_ptr<AbstractTaskRunner> taskRunner);
+
  private:
   AbstractTaskRunner::Shared getTaskRunner(TaskThread taskThread) const;
 
@@ -7,12 +7,14 @@
 
 #include "TextMeasurer.h"
 #include <cxxreact/SystraceSection.h>
+#include <folly/hash/SpookyHashV2.h>
 #include <native_drawing/drawing_register_font.h>
 #include <react/renderer/graphics/rounding.h>
 #include <memory>
 #include "RNOH/ArkUITypography.h"
 #include "RNOH/StyledStringWrapper.h"
 #include "RNOH/TextConversions.h"
+#include "RNOH/UnicodeTranscoding.h"
 
 namespace rnoh {
 
@@ -80,45 +82,83 @@ facebook::react::TextMeasurement TextMeasurer::measure(
     const facebook::react::TextLayoutContext& layoutContext,
     facebook::react::LayoutConstraints layoutConstraints) {
   facebook::react::SystraceSection s("#RNOH::TextMeasurer::measure");
+  auto& attributedString = attributedStringBox.getValue();
+  auto textIdentity =
+      getTextIdentity(attributedString, paragraphAttributes, layoutContext);
   auto textStorage = createTextStorage(
-      attributedStringBox.getValue(),
+      textIdentity,
+      attributedString,
       paragraphAttributes,
       layoutContext,
-      std::move(layoutConstraints));
-  setTextStorage(textStorage);
-  return textStorage->arkUITypography.getMeasurement();
+      layoutConstraints);
+  // the text storage may have been created for other layout constraints
+  auto measurement =
+      textStorage->arkUITypography.getMeasurement(layoutConstraints);
+  setTextStorage(
+      textStorage, textIdentity.fingerprint, measurement.size.width);
+  return measurement;
 }
 facebook::react::LinesMeasurements TextMeasurer::measureLines(
     const facebook::react::AttributedStringBox& attributedStringBox,
     const facebook::react::ParagraphAttributes& paragraphAttributes,
     const facebook::react::Size& size) {
   auto& attributedString = attributedStringBox.getValue();
-  auto textStorage = getTextStorage(
-      {attributedString,
-       paragraphAttributes,
-       {m_scale},
-       static_cast<int>(ceil(size.width * m_scale))});
-  if (!textStorage) {
-    textStorage = createTextStorage(
-        attributedString, paragraphAttributes, {m_scale}, {size, size});
-  }
+  auto textStorage =
+      getOrCreateTextStorage(attributedString, paragraphAttributes, size);
   auto& typography = textStorage->arkUITypography;
-  std::stringstream ss;
+  // reused by every measurement on this thread, to keep its capacity
+  thread_local std::u16string u16Text;
+  u16Text.clear();
   bool hasAttachmentCharacter = false;
   for (auto const& fragment : attributedString.getFragments()) {
     if (fragment.isAttachment()) {
       hasAttachmentCharacter = true;
     }
-    ss << fragment.string;
+    appendUtf8AsUtf16(fragment.string, u16Text);
   }
-  std::u16string u16Text =
-      std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>{}
-          .from_bytes(ss.str());
   return getLinesMeasurements(typography, u16Text, hasAttachmentCharacter);
 };
+facebook::react::Float TextMeasurer::baseline(
+    const facebook::react::AttributedStringBox& attributedStringBox,
+    const facebook::react::ParagraphAttributes& paragraphAttributes,
+    const facebook::react::Size& size) {
+  if (attributedStringBox.getMode() !=
+      facebook::react::AttributedStringBox::Mode::Value) {
+    return 0;
+  }
+  auto textStorage = getOrCreateTextStorage(
+      attributedStringBox.getValue(), paragraphAttributes, size);
+  return textStorage->arkUITypography.getAlphabeticBaseline();
+}
+
+TextMeasurer::TextStorage::Shared TextMeasurer::getOrCreateTextStorage(
+    facebook::react::AttributedString const& attributedString,
+    facebook::react::ParagraphAttributes const& paragraphAttributes,
+    facebook::react::Size const& size) {
+  facebook::react::TextLayoutContext layoutContext{};
+  layoutContext.pointScaleFactor = m_scale;
+  auto textIdentity =
+      getTextIdentity(attributedString, paragraphAttributes, layoutContext);
+  auto textStorage = getTextStorage(
+      textIdentity,
+      attributedString,
+      paragraphAttributes,
+      layoutContext,
+      static_cast<int>(ceil(size.width * m_scale)));
+  if (!textStorage) {
+    textStorage = createTextStorage(
+        textIdentity,
+        attributedString,
+        paragraphAttributes,
+        layoutContext,
+        {size, size});
+  }
+  return textStorage;
+}
+
 facebook::react::LinesMeasurements TextMeasurer::getLinesMeasurements(
     ArkUITypography& typography,
-    std::u16string& u16Text,
+    std::u16string_view u16Text,
     bool hasAttachmentCharacter) {
   auto metrics =
       OH_Drawing_TypographyGetLineMetrics(typography.m_typography.get());
@@ -129,17 +169,22 @@ facebook::react::LinesMeasurements TextMeasurer::getLinesMeasurements(
     OH_Drawing_TypographyGetLineMetricsAt(
         typography.m_typography.get(), i, metrics);
     auto u16LineText = u16Text.substr(
-        metrics->startIndex, metrics->endIndex - metrics->startIndex);
+        std::min<size_t>(metrics->startIndex, u16Text.size()),
+        metrics->endIndex - metrics->startIndex);
+    std::string lineText;
     if (hasAttachmentCharacter) {
-      // NOTE: Use std::remove and erase to remove the placeholder character
-      // `\uFFFC` in the UTF-16 string (corresponding to `0xFFFC` in UTF-16)
-      u16LineText.erase(
-          std::remove(u16LineText.begin(), u16LineText.end(), 0xFFFC),
-          u16LineText.end());
+      // NOTE: skip the placeholder character `\uFFFC` of attachments
+      size_t runStart = 0;
+      for (size_t j = 0; j <= u16LineText.size(); j++) {
+        if (j == u16LineText.size() || u16LineText[j] == 0xFFFC) {
+          appendUtf16AsUtf8(
+              u16LineText.substr(runStart, j - runStart), lineText);
+          runStart = j + 1;
+        }
+      }
+    } else {
+      appendUtf16AsUtf8(u16LineText, lineText);
     }
-    std::string lineText =
-        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>{}
-            .to_bytes(u16LineText);
     facebook::react::LineMeasurement measurement(
         lineText,
         {{metrics->x / m_scale, metrics->y / m_scale},
@@ -158,6 +203,20 @@ TextMeasurer::TextStorage::Shared TextMeasurer::createTextStorage(
     facebook::react::ParagraphAttributes paragraphAttributes,
     facebook::react::TextLayoutContext layoutContext,
     facebook::react::LayoutConstraints layoutConstraints) const {
+  return createTextStorage(
+      getTextIdentity(attributedString, paragraphAttributes, layoutContext),
+      attributedString,
+      paragraphAttributes,
+      layoutContext,
+      layoutConstraints);
+}
+
+auto TextMeasurer::createTextStorage(
+    TextIdentity const& textIdentity,
+    AttributedString const& attributedString,
+    ParagraphAttributes const& paragraphAttributes,
+    facebook::react::TextLayoutContext const& layoutContext,
+    LayoutConstraints const& layoutConstraints) const -> TextStorage::Shared {
   if (paragraphAttributes.adjustsFontSizeToFit) {
     int maxFontSize = 0;
     for (const auto& fragment : attributedString.getFragments()) {
@@ -166,33 +225,102 @@ TextMeasurer::TextStorage::Shared TextMeasurer::createTextStorage(
     }
     return findFitFontSize(
         maxFontSize,
+        textIdentity,
         attributedString,
         paragraphAttributes,
         layoutContext,
         layoutConstraints);
   }
 
-  auto styledString = createStyledString(attributedString, paragraphAttributes);
+  auto reusableTextStorage = findReusableTextStorage(
+      textIdentity,
+      attributedString,
+      paragraphAttributes,
+      layoutContext,
+      layoutConstraints);
+  if (reusableTextStorage != nullptr) {
+    return reusableTextStorage;
+  }
+
+  facebook::react::SystraceSection s(
+      "#RNOH::TextMeasurer::createTextStorage::shape");
+  auto styledString =
+      createStyledString(textIdentity, attributedString, paragraphAttributes);
   auto typography = ArkUITypography(
       styledString.get(),
       styledString.m_attachmentCount,
       styledString.m_fragmentLengths,
       layoutConstraints,
       m_scale);
-  return std::make_shared<TextStorage>(
+  auto textStorage = std::make_shared<TextStorage>(
       styledString,
       std::move(typography),
       attributedString,
       paragraphAttributes,
       layoutContext,
       layoutConstraints);
+  auto& shard = m_textStorageCache->getShard(textIdentity.fingerprint);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.latestTextStorageByFingerprint.set(
+      textIdentity.fingerprint, textStorage);
+  return textStorage;
 }
 
-StyledStringWrapper TextMeasurer::createStyledString(
+/**
+ * The typography of a text storage is laid out at the width of its longest
+ * line, so it stays valid for any maximum width that yields the same lines.
+ * The minimum size doesn't affect the lines, only the measurement, which is
+ * clamped to the requested constraints.
+ */
+bool TextMeasurer::canReuseTextStorage(
+    TextStorage const& textStorage,
+    LayoutConstraints const& layoutConstraints) {
+  return facebook::react::TextLayoutManager::canReuseLines(
+      textStorage.paragraphAttributes,
+      textStorage.layoutConstraints,
+      textStorage.arkUITypography.getLongestLineWidth(),
+      layoutConstraints);
+}
+
+auto TextMeasurer::findReusableTextStorage(
+    TextIdentity const& textIdentity,
     AttributedString const& attributedString,
+    ParagraphAttributes const& paragraphAttributes,
+    facebook::react::TextLayoutContext const& layoutContext,
+    LayoutConstraints const& layoutConstraints) const -> TextStorage::Shared {
+  auto& fingerprint = textIdentity.fingerprint;
+  auto& shard = m_textStorageCache->getShard(fingerprint);
+  TextStorage::Shared textStorage = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& latestTextStorageByFingerprint =
+        shard.latestTextStorageByFingerprint;
+    auto it = latestTextStorageByFingerprint.find(fingerprint);
+    if (it == latestTextStorageByFingerprint.end()) {
+      return nullptr;
+    }
+    textStorage = it->second.lock();
+    if (textStorage == nullptr) {
+      latestTextStorageByFingerprint.erase(fingerprint);
+      return nullptr;
+    }
+  }
+  if (!canReuseTextStorage(*textStorage, layoutConstraints) ||
+      !isTextStorageOf(
+          *textStorage,
+          textIdentity,
+          attributedString,
+          paragraphAttributes,
+          layoutContext)) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.widthReuses++;
+  return textStorage;
+}
+
+float TextMeasurer::getFontMultiplier(
     ParagraphAttributes const& paragraphAttributes) const {
-  UniqueTypographyStyle typographyStyle(
-      OH_Drawing_CreateTypographyStyle(), OH_Drawing_DestroyTypographyStyle);
   float fontMultiplier = 1.0;
   if (paragraphAttributes.allowFontScaling) {
     fontMultiplier = m_fontScale;
@@ -202,6 +330,15 @@ StyledStringWrapper TextMeasurer::createStyledString(
           m_fontScale, (float)paragraphAttributes.maxFontSizeMultiplier);
     }
   }
+  return fontMultiplier;
+}
+
+StyledStringWrapper TextMeasurer::createStyledString(
+    TextIdentity const& textIdentity,
+    AttributedString const& attributedString,
+    ParagraphAttributes const& paragraphAttributes) const {
+  UniqueTypographyStyle typographyStyle(
+      OH_Drawing_CreateTypographyStyle(), OH_Drawing_DestroyTypographyStyle);
 
   if (paragraphAttributes.ellipsizeMode !=
       facebook::react::EllipsizeMode::Clip) {
@@ -249,10 +386,10 @@ StyledStringWrapper TextMeasurer::createStyledString(
 
   StyledStringWrapper styledStringWrapper(
       typographyStyle.get(),
-      m_fontRegistry->getFontCollection(),
-      m_fontRegistry->getThemeFontFamily(),
+      textIdentity.fontCollection,
+      textIdentity.themeFontFamily,
       m_scale,
-      fontMultiplier);
+      textIdentity.fontMultiplier);
   for (auto const& fragment : attributedString.getFragments()) {
     styledStringWrapper.addFragment(fragment);
   }
@@ -261,6 +398,7 @@ StyledStringWrapper TextMeasurer::createStyledString(
 
 auto TextMeasurer::findFitFontSize(
     int maxFontSize,
+    TextIdentity const& textIdentity,
     facebook::react::AttributedString const& attributedString,
     facebook::react::ParagraphAttributes const& paragraphAttributes,
     facebook::react::TextLayoutContext const& layoutContext,
@@ -268,7 +406,7 @@ auto TextMeasurer::findFitFontSize(
     -> TextStorage::Shared {
   // check if already fit
   auto finalStyledString =
-      createStyledString(attributedString, paragraphAttributes);
+      createStyledString(textIdentity, attributedString, paragraphAttributes);
   auto finalTypography = ArkUITypography(
       finalStyledString.get(),
       finalStyledString.m_attachmentCount,
@@ -308,8 +446,8 @@ auto TextMeasurer::findFitFontSize(
           newFontSize;
     }
 
-    auto styledString =
-        createStyledString(fittedAttributedString, paragraphAttributes);
+    auto styledString = createStyledString(
+        textIdentity, fittedAttributedString, paragraphAttributes);
     auto typography = ArkUITypography(
         styledString.get(),
         styledString.m_attachmentCount,
@@ -340,38 +478,232 @@ void TextMeasurer::setTextMeasureParams(float fontScale, float scale) {
   m_fontScale = fontScale;
   m_scale = scale;
   m_fontRegistry->updateThemeFont();
+  invalidateMeasurements();
+}
+
+size_t TextMeasurer::getMeasurementRevision() const {
+  return m_measurementRevision.load();
+}
+
+void TextMeasurer::invalidateMeasurements() {
+  m_measurementRevision++;
 }
 
-void TextMeasurer::setTextStorage(const TextStorage::Shared textStorage) {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_textStorageCache.set(
-      {textStorage->attributedString,
-       textStorage->paragraphAttributes,
-       textStorage->layoutContext,
-       static_cast<int>(ceil(
-           textStorage->arkUITypography.getMeasurement().size.width *
-           textStorage->layoutContext.pointScaleFactor))},
-      textStorage);
+std::shared_ptr<TextMeasurer::SharedTextStorageCache>
+TextMeasurer::acquireSharedTextStorageCache() {
+  static std::mutex mutex;
+  static std::weak_ptr<SharedTextStorageCache> weakCache;
+  auto lock = std::lock_guard(mutex);
+  auto cache = weakCache.lock();
+  if (cache == nullptr) {
+    cache = std::make_shared<SharedTextStorageCache>();
+    weakCache = cache;
+  }
+  return cache;
+}
+
+auto TextMeasurer::getTextStorageCacheStats() -> TextStorageCacheStats {
+  auto cache = acquireSharedTextStorageCache();
+  TextStorageCacheStats stats{};
+  for (auto& shard : cache->shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    stats.size += shard.textStorageByKey.size();
+    stats.bytes += shard.bytes;
+    stats.hits += shard.hits;
+    stats.misses += shard.misses;
+    stats.sharedHits += shard.sharedHits;
+    stats.widthReuses += shard.widthReuses;
+  }
+  return stats;
+}
+
+auto TextMeasurer::getTextIdentity(
+    AttributedString const& attributedString,
+    ParagraphAttributes const& paragraphAttributes,
+    facebook::react::TextLayoutContext const& layoutContext) const
+    -> TextIdentity {
+  auto fontCollection = m_fontRegistry->getFontCollection();
+  auto fontMultiplier = getFontMultiplier(paragraphAttributes);
+  auto themeFontFamily = m_fontRegistry->getThemeFontFamily();
+  auto fingerprint = getTextFingerprint(
+      attributedString,
+      paragraphAttributes,
+      layoutContext,
+      fontCollection.get(),
+      fontMultiplier,
+      themeFontFamily);
+  return {
+      fingerprint,
+      std::move(fontCollection),
+      fontMultiplier,
+      std::move(themeFontFamily)};
+}
+
+auto TextMeasurer::getTextFingerprint(
+    AttributedString const& attributedString,
+    ParagraphAttributes const& paragraphAttributes,
+    facebook::react::TextLayoutContext const& layoutContext,
+    OH_Drawing_FontCollection* fontCollection,
+    float fontMultiplier,
+    std::string const& themeFontFamily) -> TextFingerprint {
+  folly::hash::SpookyHashV2 hasher;
+  hasher.Init(0, 0);
+  auto update = [&hasher](auto const& value) {
+    hasher.Update(&value, sizeof(value));
+  };
+  for (auto const& fragment : attributedString.getFragments()) {
+    update(fragment.string.size());
+    hasher.Update(fragment.string.data(), fragment.string.size());
+    update(std::hash<facebook::react::TextAttributes>{}(
+        fragment.textAttributes));
+    if (fragment.isAttachment()) {
+      update(fragment.parentShadowView.layoutMetrics.frame.size.width);
+      update(fragment.parentShadowView.layoutMetrics.frame.size.height);
+    }
+  }
+  update(std::hash<ParagraphAttributes>{}(paragraphAttributes));
+  update(layoutContext.pointScaleFactor);
+  update(fontCollection);
+  update(fontMultiplier);
+  hasher.Update(themeFontFamily.data(), themeFontFamily.size());
+  TextFingerprint fingerprint{};
+  hasher.Final(&fingerprint.high, &fingerprint.low);
+  return fingerprint;
+}
+
+bool TextMeasurer::isTextStorageOf(
+    TextStorage const& textStorage,
+    TextIdentity const& textIdentity,
+    AttributedString const& attributedString,
+    ParagraphAttributes const& paragraphAttributes,
+    facebook::react::TextLayoutContext const& layoutContext) {
+  auto& styledString = textStorage.styledString;
+  if (styledString.m_fontCollection != textIdentity.fontCollection ||
+      styledString.m_fontMultiplier != textIdentity.fontMultiplier ||
+      styledString.m_themeFontFamilyName != textIdentity.themeFontFamily ||
+      !(textStorage.paragraphAttributes == paragraphAttributes) ||
+      textStorage.layoutContext.pointScaleFactor !=
+          layoutContext.pointScaleFactor) {
+    return false;
+  }
+  auto& fragments = textStorage.attributedString.getFragments();
+  auto& otherFragments = attributedString.getFragments();
+  if (fragments.size() != otherFragments.size()) {
+    return false;
+  }
+  for (auto i = size_t{0}; i < fragments.size(); i++) {
+    auto& fragment = fragments[i];
+    auto& otherFragment = otherFragments[i];
+    if (!(fragment.string == otherFragment.string &&
+          fragment.textAttributes == otherFragment.textAttributes &&
+          // LayoutMetrics of an attachment fragment affects the size of a
+          // measured attributed string.
+          (!fragment.isAttachment() ||
+           (fragment.parentShadowView.layoutMetrics ==
+            otherFragment.parentShadowView.layoutMetrics)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * A rough estimate: the retained attributed string plus the native styled
+ * string and typography, whose size grows with the text length.
+ */
+size_t TextMeasurer::estimateTextStorageBytes(TextStorage const& textStorage) {
+  static constexpr size_t nativeBytesPerTextByte = 32;
+  static constexpr size_t nativeBytesPerFragment = 512;
+  auto bytes = sizeof(TextStorage);
+  for (auto const& fragment : textStorage.attributedString.getFragments()) {
+    bytes += sizeof(fragment) + fragment.string.capacity() +
+        nativeBytesPerFragment +
+        fragment.string.size() * nativeBytesPerTextByte;
+  }
+  return bytes;
+}
+
+void TextMeasurer::setTextStorage(
+    const TextStorage::Shared textStorage,
+    TextFingerprint const& fingerprint,
+    facebook::react::Float measuredWidth) {
+  TextStorageCacheKey key{
+      fingerprint,
+      static_cast<int>(
+          ceil(measuredWidth * textStorage->layoutContext.pointScaleFactor))};
+  auto bytes = estimateTextStorageBytes(*textStorage);
+  auto& shard = m_textStorageCache->getShard(key.fingerprint);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto& textStorageByKey = shard.textStorageByKey;
+  auto it = textStorageByKey.find(key);
+  if (it != textStorageByKey.end()) {
+    shard.bytes -= it->second.bytes;
+  }
+  textStorageByKey.set(key, {textStorage, m_rnInstanceId, bytes});
+  shard.bytes += bytes;
+  // evict the least recently used text storages, but keep the new one even
+  // if it exceeds the cap on its own
+  while (shard.bytes >
+             textStorageCacheBytesCap / textStorageCacheShardsCount &&
+         textStorageByKey.size() > 1) {
+    auto lruIt = textStorageByKey.rbegin();
+    shard.bytes -= lruIt->second.bytes;
+    textStorageByKey.erase(lruIt->first);
+  }
 }
 
 TextMeasurer::TextStorage::Shared TextMeasurer::getTextStorage(
     const CacheKey& key) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  return getTextStorage(
+      getTextIdentity(
+          key.attributedString, key.paragraphAttributes, key.layoutContext),
+      key.attributedString,
+      key.paragraphAttributes,
+      key.layoutContext,
+      key.ceiledWidth);
+}
+
+auto TextMeasurer::getTextStorage(
+    TextIdentity const& textIdentity,
+    AttributedString const& attributedString,
+    ParagraphAttributes const& paragraphAttributes,
+    facebook::react::TextLayoutContext const& layoutContext,
+    px ceiledWidth) -> TextStorage::Shared {
+  TextStorageCacheKey cacheKey{textIdentity.fingerprint, ceiledWidth};
+  auto& shard = m_textStorageCache->getShard(cacheKey.fingerprint);
+  std::lock_guard<std::mutex> lock(shard.mutex);
   // right/left may be ceil/floor to integer, make width = right - left have
   // error of 2 at most
   // errors ordered by frequency
   static constexpr std::array<px, 4> errors = {-1, 0, +1, -2};
   for (auto error : errors) {
-    auto it = m_textStorageCache.find(
-        {key.attributedString,
-         key.paragraphAttributes,
-         key.layoutContext,
-         key.ceiledWidth + error});
-    if (it != m_textStorageCache.end()) {
-      return it->second;
+    cacheKey.ceiledWidth = ceiledWidth + error;
+    auto it = shard.textStorageByKey.find(cacheKey);
+    if (it != shard.textStorageByKey.end() &&
+        isTextStorageOf(
+            *it->second.textStorage,
+            textIdentity,
+            attributedString,
+            paragraphAttributes,
+            layoutContext)) {
+      shard.hits++;
+      if (it->second.rnInstanceId != m_rnInstanceId) {
+        shard.sharedHits++;
+      }
+      return it->second.textStorage;
     }
   }
+  shard.misses++;
   return nullptr;
 }
 
+void TextMeasurer::clearTextStorageCache() {
+  for (auto& shard : m_textStorageCache->shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.textStorageByKey.clear();
+    shard.latestTextStorageByFingerprint.clear();
+    shard.bytes = 0;
+  }
+}
+
 } // namespace rnoh
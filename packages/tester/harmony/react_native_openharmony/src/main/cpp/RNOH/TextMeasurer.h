@@ -8,9 +8,11 @@
 #pragma once
 #include <react/renderer/graphics/Size.h>
 #include <react/renderer/textlayoutmanager/TextLayoutManager.h>
-#include <codecvt>
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include "ArkUITypography.h"
 #include "FontRegistry.h"
 #include "Graphics.h"
@@ -19,9 +21,19 @@
 namespace rnoh {
 
 /*
- * Maximum size of the textStorageCache.
+ * Maximum estimated size of the textStorageCache, in bytes.
  */
-constexpr auto textStorageThreadSafeCacheSizeCap = size_t{2048};
+constexpr auto textStorageCacheBytesCap = size_t{16 * 1024 * 1024};
+
+/*
+ * Maximum number of texts whose text storage can be reused for other widths.
+ */
+constexpr auto textStorageByFingerprintSizeCap = size_t{2048};
+
+/*
+ * Number of independently locked parts of the textStorageCache.
+ */
+constexpr auto textStorageCacheShardsCount = size_t{8};
 
 class TextMeasurer final : public facebook::react::TextLayoutManagerDelegate {
  public:
@@ -31,52 +43,6 @@ class TextMeasurer final : public facebook::react::TextLayoutManagerDelegate {
     facebook::react::ParagraphAttributes paragraphAttributes{};
     facebook::react::TextLayoutContext layoutContext;
     px ceiledWidth;
-
-    bool operator==(const CacheKey& other) const {
-      auto& fragments = attributedString.getFragments();
-      auto& otherFragments = other.attributedString.getFragments();
-
-      if (fragments.size() != otherFragments.size()) {
-        return false;
-      }
-
-      auto size = fragments.size();
-      for (auto i = size_t{0}; i < size; i++) {
-        auto& fragment = fragments.at(i);
-        auto& otherFragment = otherFragments.at(i);
-        if (!(fragment.string == otherFragment.string &&
-              fragment.textAttributes == otherFragment.textAttributes &&
-              // LayoutMetrics of an attachment fragment affects the size of a
-              // measured attributed string.
-              (!fragment.isAttachment() ||
-               (fragment.parentShadowView.layoutMetrics ==
-                otherFragment.parentShadowView.layoutMetrics)))) {
-          return false;
-        }
-      }
-
-      return paragraphAttributes == other.paragraphAttributes &&
-          layoutContext.pointScaleFactor ==
-          other.layoutContext.pointScaleFactor &&
-          ceiledWidth == other.ceiledWidth;
-    }
-    struct Hasher {
-      size_t operator()(const CacheKey& key) const {
-        auto seed = size_t{0};
-
-        for (const auto& fragment : key.attributedString.getFragments()) {
-          facebook::react::hash_combine(
-              seed, fragment.string, fragment.textAttributes);
-        }
-
-        facebook::react::hash_combine(
-            seed,
-            key.paragraphAttributes,
-            key.layoutContext.pointScaleFactor,
-            key.ceiledWidth);
-        return seed;
-      }
-    };
   };
   /**
    * @threadSafe
@@ -112,12 +78,25 @@ class TextMeasurer final : public facebook::react::TextLayoutManagerDelegate {
           layoutConstraints(layoutConstraints) {}
   };
 
+  struct TextStorageCacheStats {
+    size_t size;
+    // estimated, see `textStorageCacheBytesCap`
+    size_t bytes;
+    uint64_t hits;
+    uint64_t misses;
+    // hits on text storages created by another RN instance
+    uint64_t sharedHits;
+    // text storages created for one width and reused for another
+    uint64_t widthReuses;
+  };
+
   TextMeasurer(
       FeatureFlagRegistry::Shared featureFlagManager,
       FontRegistry::Shared fontRegistry,
       int id)
       : m_featureFlagRegistry(featureFlagManager),
         m_fontRegistry(std::move(fontRegistry)),
+        m_textStorageCache(acquireSharedTextStorageCache()),
         m_rnInstanceId(id) {}
 
   ~TextMeasurer() {
@@ -135,6 +114,24 @@ class TextMeasurer final : public facebook::react::TextLayoutManagerDelegate {
       const facebook::react::ParagraphAttributes& paragraphAttributes,
       const facebook::react::Size& size) override;
 
+  /**
+   * @brief Returns the baseline of the first line, reading it from the
+   * text storage created when the text was measured.
+   */
+  facebook::react::Float baseline(
+      const facebook::react::AttributedStringBox& attributedStringBox,
+      const facebook::react::ParagraphAttributes& paragraphAttributes,
+      const facebook::react::Size& size) override;
+
+  size_t getMeasurementRevision() const override;
+
+  /**
+   * @brief Makes measurements cached by the TextLayoutManager stale, e.g.
+   * after a font was registered.
+   * @threadSafe
+   */
+  void invalidateMeasurements();
+
   TextStorage::Shared createTextStorage(
       facebook::react::AttributedString attributedString,
       facebook::react::ParagraphAttributes paragraphAttributes,
@@ -148,35 +145,223 @@ class TextMeasurer final : public facebook::react::TextLayoutManagerDelegate {
    */
   TextStorage::Shared getTextStorage(const CacheKey& key);
 
+  /**
+   * @brief Drops all cached text storages. Called on memory pressure.
+   * @threadSafe
+   */
+  void clearTextStorageCache();
+
+  /**
+   * @threadSafe
+   */
+  static TextStorageCacheStats getTextStorageCacheStats();
+
  private:
+  /**
+   * 128-bit fingerprint of everything a text storage depends on, except the
+   * layout width: the text, its attributes and the fonts. It's computed once
+   * per lookup, so probing several widths doesn't rehash the text. Equal
+   * fingerprints are confirmed by comparing the text storage itself.
+   */
+  struct TextFingerprint {
+    uint64_t high;
+    uint64_t low;
+
+    bool operator==(const TextFingerprint& other) const {
+      return high == other.high && low == other.low;
+    }
+
+    struct Hasher {
+      size_t operator()(const TextFingerprint& fingerprint) const {
+        return static_cast<size_t>(fingerprint.low);
+      }
+    };
+  };
+
+  /**
+   * Text storages are cached process-wide, so RN instances rendering the same
+   * text with the same fonts reuse each other's layouts. The font collection
+   * identifies the set of registered fonts. Cached text storages keep their
+   * font collection alive, so its address can't be reused while an entry
+   * refers to it.
+   */
+  struct TextStorageCacheKey {
+    TextFingerprint fingerprint;
+    px ceiledWidth;
+
+    bool operator==(const TextStorageCacheKey& other) const {
+      return fingerprint == other.fingerprint &&
+          ceiledWidth == other.ceiledWidth;
+    }
+
+    struct Hasher {
+      size_t operator()(const TextStorageCacheKey& key) const {
+        auto seed = static_cast<size_t>(key.fingerprint.low);
+        facebook::react::hash_combine(seed, key.ceiledWidth);
+        return seed;
+      }
+    };
+  };
+
+  /**
+   * Everything a text storage depends on, except the layout constraints.
+   * Read once per measurement and passed down, so that a cache miss neither
+   * rehashes the text nor locks the font registry again.
+   */
+  struct TextIdentity {
+    TextFingerprint fingerprint;
+    SharedFontCollection fontCollection;
+    float fontMultiplier;
+    std::string themeFontFamily;
+  };
+
+  struct CachedTextStorage {
+    TextStorage::Shared textStorage;
+    int rnInstanceId;
+    size_t bytes;
+  };
+
+  /**
+   * Shared by all TextMeasurers and released with the last of them. Bounded
+   * by the estimated bytes of the cached text storages rather than by their
+   * count, since a long text costs far more than a short label. Split into
+   * shards by fingerprint, so that texts measured concurrently rarely contend
+   * for the same lock.
+   */
+  struct SharedTextStorageCache {
+    struct Shard {
+      std::mutex mutex;
+      // unbounded by count, pruned by `bytes`
+      folly::EvictingCacheMap<
+          TextStorageCacheKey,
+          CachedTextStorage,
+          TextStorageCacheKey::Hasher>
+          textStorageByKey{0};
+      // the latest text storage of each text, regardless of its width
+      folly::EvictingCacheMap<
+          TextFingerprint,
+          std::weak_ptr<TextStorage>,
+          TextFingerprint::Hasher>
+          latestTextStorageByFingerprint{
+              textStorageByFingerprintSizeCap / textStorageCacheShardsCount};
+      size_t bytes = 0;
+      uint64_t hits = 0;
+      uint64_t misses = 0;
+      uint64_t sharedHits = 0;
+      uint64_t widthReuses = 0;
+    };
+
+    std::array<Shard, textStorageCacheShardsCount> shards;
+
+    Shard& getShard(TextFingerprint const& fingerprint) {
+      return shards[fingerprint.high % shards.size()];
+    }
+  };
+
+  static std::shared_ptr<SharedTextStorageCache>
+  acquireSharedTextStorageCache();
+
+  /**
+   * @threadSafe
+   */
+  TextIdentity getTextIdentity(
+      facebook::react::AttributedString const& attributedString,
+      facebook::react::ParagraphAttributes const& paragraphAttributes,
+      facebook::react::TextLayoutContext const& layoutContext) const;
+
+  static TextFingerprint getTextFingerprint(
+      facebook::react::AttributedString const& attributedString,
+      facebook::react::ParagraphAttributes const& paragraphAttributes,
+      facebook::react::TextLayoutContext const& layoutContext,
+      OH_Drawing_FontCollection* fontCollection,
+      float fontMultiplier,
+      std::string const& themeFontFamily);
+
+  static bool isTextStorageOf(
+      TextStorage const& textStorage,
+      TextIdentity const& textIdentity,
+      facebook::react::AttributedString const& attributedString,
+      facebook::react::ParagraphAttributes const& paragraphAttributes,
+      facebook::react::TextLayoutContext const& layoutContext);
+
+  static size_t estimateTextStorageBytes(TextStorage const& textStorage);
+
+  static bool canReuseTextStorage(
+      TextStorage const& textStorage,
+      facebook::react::LayoutConstraints const& layoutConstraints);
+
+  /**
+   * @threadSafe
+   * @brief Finds a text storage of the same text, created for other layout
+   * constraints, whose lines wouldn't change with the given constraints.
+   */
+  TextStorage::Shared findReusableTextStorage(
+      TextIdentity const& textIdentity,
+      facebook::react::AttributedString const& attributedString,
+      facebook::react::ParagraphAttributes const& paragraphAttributes,
+      facebook::react::TextLayoutContext const& layoutContext,
+      facebook::react::LayoutConstraints const& layoutConstraints) const;
+
+  float getFontMultiplier(
+      facebook::react::ParagraphAttributes const& paragraphAttributes) const;
+
   TextStorage::Shared findFitFontSize(
       int maxFontSize,
+      TextIdentity const& textIdentity,
       facebook::react::AttributedString const& attributedString,
       facebook::react::ParagraphAttributes const& paragraphAttributes,
       facebook::react::TextLayoutContext const& layoutContext,
       facebook::react::LayoutConstraints const& layoutConstraints) const;
 
   StyledStringWrapper createStyledString(
+      TextIdentity const& textIdentity,
       facebook::react::AttributedString const& attributedString,
       facebook::react::ParagraphAttributes const& paragraphAttributes) const;
 
+  TextStorage::Shared createTextStorage(
+      TextIdentity const& textIdentity,
+      facebook::react::AttributedString const& attributedString,
+      facebook::react::ParagraphAttributes const& paragraphAttributes,
+      facebook::react::TextLayoutContext const& layoutContext,
+      facebook::react::LayoutConstraints const& layoutConstraints) const;
+
+  /**
+   * @threadSafe
+   */
+  TextStorage::Shared getTextStorage(
+      TextIdentity const& textIdentity,
+      facebook::react::AttributedString const& attributedString,
+      facebook::react::ParagraphAttributes const& paragraphAttributes,
+      facebook::react::TextLayoutContext const& layoutContext,
+      px ceiledWidth);
+
+  /**
+   * @brief Returns the text storage of a text already laid out with the
+   * given size, creating one if it was evicted.
+   */
+  TextStorage::Shared getOrCreateTextStorage(
+      facebook::react::AttributedString const& attributedString,
+      facebook::react::ParagraphAttributes const& paragraphAttributes,
+      facebook::react::Size const& size);
+
   facebook::react::LinesMeasurements getLinesMeasurements(
       ArkUITypography& typography,
-      std::u16string& u16Text,
+      std::u16string_view u16Text,
       bool hasAttachmentCharacter);
 
   /**
    * @threadSafe
    */
-  void setTextStorage(const TextStorage::Shared textStorage);
+  void setTextStorage(
+      const TextStorage::Shared textStorage,
+      TextFingerprint const& fingerprint,
+      facebook::react::Float measuredWidth);
 
   FeatureFlagRegistry::Shared m_featureFlagRegistry;
   FontRegistry::Shared m_fontRegistry;
-  mutable folly::
-      EvictingCacheMap<CacheKey, TextStorage::Shared, CacheKey::Hasher>
-          m_textStorageCache{rnoh::textStorageThreadSafeCacheSizeCap};
-  std::mutex m_mutex;
+  std::shared_ptr<SharedTextStorageCache> m_textStorageCache;
 
+  std::atomic<size_t> m_measurementRevision = 0;
   float m_fontScale = 1.0f;
   float m_scale = 1.0f;
   int m_rnInstanceId = 0;
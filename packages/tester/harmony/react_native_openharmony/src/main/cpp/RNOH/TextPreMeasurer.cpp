@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "TextPreMeasurer.h"
+#include <cxxreact/SystraceSection.h>
+#include <glog/logging.h>
+#include <react/renderer/components/root/RootShadowNode.h>
+#include <react/renderer/components/text/ParagraphShadowNode.h>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace rnoh {
+
+using namespace facebook;
+
+/**
+ * Below this number of texts, waking up the workers costs more than it saves.
+ */
+constexpr size_t MIN_JOBS_COUNT = 16;
+/**
+ * Including the committing thread.
+ */
+constexpr size_t MAX_THREADS_COUNT = 4;
+
+struct TextPreMeasurer::Batch {
+  std::vector<Job> jobs;
+  react::TextLayoutContext textLayoutContext;
+  std::shared_ptr<TextMeasurer> textMeasurer;
+  std::atomic_size_t nextJobIndex = 0;
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t finishedJobsCount = 0;
+
+  /**
+   * Measures texts until every job was claimed.
+   */
+  void work() {
+    for (auto i = nextJobIndex++; i < jobs.size(); i = nextJobIndex++) {
+      auto const& job = jobs[i];
+      try {
+        textMeasurer->measure(
+            react::AttributedStringBox{job.attributedString},
+            job.paragraphAttributes,
+            textLayoutContext,
+            job.layoutConstraints);
+      } catch (std::exception const& e) {
+        LOG(WARNING) << "Couldn't pre-measure text: " << e.what();
+      }
+      std::lock_guard lock(mtx);
+      if (++finishedJobsCount == jobs.size()) {
+        cv.notify_all();
+      }
+    }
+  }
+};
+
+TextPreMeasurer::TextPreMeasurer(std::shared_ptr<TextMeasurer> textMeasurer)
+    : m_textMeasurer(std::move(textMeasurer)) {
+  auto threadsCount = std::min<size_t>(
+      MAX_THREADS_COUNT, std::max(1u, std::thread::hardware_concurrency()));
+  for (size_t i = 1; i < threadsCount; i++) {
+    m_workers.push_back(std::make_unique<ThreadTaskRunner>(
+        "RNOH_TEXT_" + std::to_string(i)));
+  }
+}
+
+react::RootShadowNode::Unshared TextPreMeasurer::shadowTreeWillCommit(
+    react::ShadowTree const& /*shadowTree*/,
+    react::RootShadowNode::Shared const& /*oldRootShadowNode*/,
+    react::RootShadowNode::Unshared const& newRootShadowNode) noexcept {
+  facebook::react::SystraceSection s("#RNOH::TextPreMeasurer::preMeasure");
+  auto const& rootProps = newRootShadowNode->getConcreteProps();
+  std::vector<Job> jobs;
+  collectJobs(
+      *newRootShadowNode,
+      rootProps.layoutContext,
+      rootProps.layoutConstraints.maximumSize.width,
+      jobs);
+  if (jobs.size() >= MIN_JOBS_COUNT) {
+    react::TextLayoutContext textLayoutContext{};
+    textLayoutContext.pointScaleFactor =
+        rootProps.layoutContext.pointScaleFactor;
+    runJobs(std::move(jobs), textLayoutContext);
+  }
+  return newRootShadowNode;
+}
+
+void TextPreMeasurer::collectJobs(
+    react::ShadowNode const& shadowNode,
+    react::LayoutContext const& layoutContext,
+    react::Float availableWidth,
+    std::vector<Job>& jobs) const {
+  auto layoutableShadowNode =
+      dynamic_cast<react::LayoutableShadowNode const*>(&shadowNode);
+  if (layoutableShadowNode == nullptr) {
+    return;
+  }
+  // Yoga dirties every ancestor of a dirty node, so clean subtrees contain
+  // no text to measure
+  if (layoutableShadowNode->getIsLayoutClean()) {
+    return;
+  }
+  // nodes cloned from a laid out node keep its layout metrics until the
+  // next layout
+  auto const& layoutMetrics = layoutableShadowNode->getLayoutMetrics();
+  auto contentWidth = layoutMetrics.getContentFrame().size.width;
+  if (!(layoutMetrics == react::EmptyLayoutMetrics) && contentWidth > 0) {
+    availableWidth = contentWidth;
+  }
+
+  auto paragraphShadowNode =
+      dynamic_cast<react::ParagraphShadowNode const*>(&shadowNode);
+  if (paragraphShadowNode == nullptr) {
+    for (auto const& child : shadowNode.getChildren()) {
+      collectJobs(*child, layoutContext, availableWidth, jobs);
+    }
+    return;
+  }
+
+  // mirrors ParagraphShadowNode::getContent
+  auto const& props = paragraphShadowNode->getConcreteProps();
+  auto textAttributes = react::TextAttributes::defaultTextAttributes();
+  textAttributes.fontSizeMultiplier = layoutContext.fontSizeMultiplier;
+  textAttributes.apply(props.textAttributes);
+  textAttributes.layoutDirection =
+      layoutMetrics.layoutDirection == react::LayoutDirection::RightToLeft
+      ? react::LayoutDirection::RightToLeft
+      : react::LayoutDirection::LeftToRight;
+  react::AttributedString attributedString;
+  react::ParagraphShadowNode::Attachments attachments;
+  react::ParagraphShadowNode::buildAttributedString(
+      textAttributes, *paragraphShadowNode, attributedString, attachments);
+  // attachments are measured by the layout itself
+  if (attributedString.isEmpty() || !attachments.empty()) {
+    return;
+  }
+  jobs.push_back(
+      {std::move(attributedString),
+       props.paragraphAttributes,
+       {{0, 0},
+        {availableWidth, std::numeric_limits<react::Float>::infinity()},
+        textAttributes.layoutDirection.value()}});
+}
+
+void TextPreMeasurer::runJobs(
+    std::vector<Job> jobs,
+    react::TextLayoutContext const& textLayoutContext) const {
+  auto batch = std::make_shared<Batch>();
+  batch->jobs = std::move(jobs);
+  batch->textLayoutContext = textLayoutContext;
+  batch->textMeasurer = m_textMeasurer;
+  for (auto const& worker : m_workers) {
+    worker->runAsyncTask([batch] { batch->work(); });
+  }
+  // the committing thread is one of the workers, and measures every text
+  // if the others are late
+  batch->work();
+  std::unique_lock lock(batch->mtx);
+  batch->cv.wait(
+      lock, [&] { return batch->finishedJobsCount == batch->jobs.size(); });
+  DLOG(INFO) << "Pre-measured " << batch->jobs.size() << " texts on up to "
+             << m_workers.size() + 1 << " threads";
+}
+
+} // namespace rnoh
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <react/renderer/attributedstring/AttributedString.h>
+#include <react/renderer/attributedstring/ParagraphAttributes.h>
+#include <react/renderer/core/LayoutConstraints.h>
+#include <react/renderer/uimanager/UIManagerCommitHook.h>
+#include <memory>
+#include <vector>
+#include "RNOH/TaskExecutor/ThreadTaskRunner.h"
+#include "RNOH/TextMeasurer.h"
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * Measures the texts of a committed shadow tree on several threads before
+ * Yoga lays the tree out on the committing thread, so that Yoga's text
+ * measurements mostly reuse the text storages created here.
+ *
+ * Layout constraints aren't known before the layout, so they're guessed:
+ * a text is measured at the width it had after the previous layout or, for
+ * a new text, at the width of its closest laid out ancestor. Guesses which
+ * turn out wrong only cost the time of the workers.
+ *
+ * The worker threads are started once, with the pre-measurer, and stopped
+ * when the RN instance owning it is destroyed.
+ */
+class TextPreMeasurer : public facebook::react::UIManagerCommitHook {
+ public:
+  using Shared = std::shared_ptr<TextPreMeasurer>;
+
+  explicit TextPreMeasurer(std::shared_ptr<TextMeasurer> textMeasurer);
+
+  void commitHookWasRegistered(
+      facebook::react::UIManager const& uiManager) noexcept override {}
+
+  void commitHookWasUnregistered(
+      facebook::react::UIManager const& uiManager) noexcept override {}
+
+  facebook::react::RootShadowNode::Unshared shadowTreeWillCommit(
+      facebook::react::ShadowTree const& shadowTree,
+      facebook::react::RootShadowNode::Shared const& oldRootShadowNode,
+      facebook::react::RootShadowNode::Unshared const& newRootShadowNode)
+      noexcept override;
+
+ private:
+  struct Job {
+    facebook::react::AttributedString attributedString;
+    facebook::react::ParagraphAttributes paragraphAttributes;
+    facebook::react::LayoutConstraints layoutConstraints;
+  };
+
+  void collectJobs(
+      facebook::react::ShadowNode const& shadowNode,
+      facebook::react::LayoutContext const& layoutContext,
+      facebook::react::Float availableWidth,
+      std::vector<Job>& jobs) const;
+
+  /**
+   * Jobs of one commit. Shared with the workers, which may pick up their
+   * task only after the committing thread has measured every text.
+   */
+  struct Batch;
+
+  void runJobs(
+      std::vector<Job> jobs,
+      facebook::react::TextLayoutContext const& textLayoutContext) const;
+
+  std::shared_ptr<TextMeasurer> m_textMeasurer;
+  std::vector<std::unique_ptr<ThreadTaskRunner>> m_workers;
+};
+
+} // namespace rnoh
@@ -27,6 +27,8 @@ TurboModuleFactory::TurboModuleFactory(
     : m_arkTSTurboModuleEnvironmentByTaskThread(
           std::move(arkTSTurboModuleEnvironmentByTaskThread)),
       m_featureFlagRegistry(std::move(featureFlagRegistry)),
+      m_workerThreadEnabledFlag(
+          m_featureFlagRegistry->getFeatureFlag("WORKER_THREAD_ENABLED")),
       m_taskExecutor(taskExecutor),
       m_delegates(delegates),
       m_arkTSMessageHub(arkTSMessageHub),
@@ -71,7 +73,8 @@ TurboModuleFactory::SharedTurboModule TurboModuleFactory::create(
       .scheduler = scheduler,
       .displayMetricsManager = m_displayMetricsManager};
 
-  RNOHMarker::logMarker(RNOHMarker::RNOHMarkerId::CREATE_MODULE_START);
+  RNOHMarker::logMarker(
+      RNOHMarker::RNOHMarkerId::CREATE_MODULE_START, name.c_str());
   auto result = this->delegateCreatingTurboModule(ctx, name);
   if (result != nullptr) {
     auto arkTSTurboModule =
@@ -79,17 +82,19 @@ TurboModuleFactory::SharedTurboModule TurboModuleFactory::create(
     if (arkTSTurboModule != nullptr && !ctx.arkTSTurboModuleInstanceRef) {
       std::vector<std::string> suggestions = {
           "Have you linked a package that provides this turbo module on the ArkTS side?"};
-      if (!m_featureFlagRegistry->isFeatureFlagOn("WORKER_THREAD_ENABLED")) {
+      if (!m_workerThreadEnabledFlag.isOn()) {
         suggestions.push_back(
             "Is this a WorkerTurboModule? If so, it requires the Worker thread to be enabled. Check RNAbility::getRNOHWorkerScriptUrl.");
       }
-      RNOHMarker::logMarker(RNOHMarker::RNOHMarkerId::CREATE_MODULE_END);
+      RNOHMarker::logMarker(
+          RNOHMarker::RNOHMarkerId::CREATE_MODULE_END, name.c_str());
       throw FatalRNOHError(
           std::string("Couldn't find Turbo Module on the ArkTs side, name: '")
               .append(name),
           suggestions);
     }
-    RNOHMarker::logMarker(RNOHMarker::RNOHMarkerId::CREATE_MODULE_END);
+    RNOHMarker::logMarker(
+        RNOHMarker::RNOHMarkerId::CREATE_MODULE_END, name.c_str());
     return result;
   }
 
@@ -101,21 +106,23 @@ TurboModuleFactory::SharedTurboModule TurboModuleFactory::create(
         [tmRef = std::move(ctx.arkTSTurboModuleInstanceRef)] {});
     std::vector<std::string> suggestions = {
         "Have you linked a package that provides this turbo module on the CPP side?"};
-    RNOHMarker::logMarker(RNOHMarker::RNOHMarkerId::CREATE_MODULE_END);
+    RNOHMarker::logMarker(
+        RNOHMarker::RNOHMarkerId::CREATE_MODULE_END, name.c_str());
     throw FatalRNOHError(
         std::string("Couldn't find Turbo Module on the ArkTs side, name: '")
             .append(name),
         suggestions);
   }
 
-  RNOHMarker::logMarker(RNOHMarker::RNOHMarkerId::CREATE_MODULE_END);
+  RNOHMarker::logMarker(
+      RNOHMarker::RNOHMarkerId::CREATE_MODULE_END, name.c_str());
 
   return this->handleUnregisteredModuleRequest(ctx, name);
 }
 
 std::optional<TaskThread> TurboModuleFactory::findArkTSTurboModuleThread(
     const std::string& turboModuleName) const {
-  if (m_featureFlagRegistry->isFeatureFlagOn("WORKER_THREAD_ENABLED")) {
+  if (m_workerThreadEnabledFlag.isOn()) {
     auto workerArkTSTurboModuleEnv =
         this->getArkTSTurboModuleEnvironmentByTaskThread(TaskThread::WORKER);
     if (this->hasArkTSTurboModule(
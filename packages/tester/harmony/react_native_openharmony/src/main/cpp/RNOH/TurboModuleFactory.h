@@ -92,6 +92,7 @@ class TurboModuleFactory final {
   std::vector<std::shared_ptr<TurboModuleFactoryDelegate>> m_delegates;
   std::shared_ptr<ArkTSMessageHub> m_arkTSMessageHub;
   FeatureFlagRegistry::Shared m_featureFlagRegistry;
+  FeatureFlagRegistry::FeatureFlag m_workerThreadEnabledFlag;
   DisplayMetricsManager::Shared m_displayMetricsManager;
 };
 
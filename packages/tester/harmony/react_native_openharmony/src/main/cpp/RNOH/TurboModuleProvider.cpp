@@ -51,6 +51,9 @@ void TurboModuleProvider::installJSBindings(
   auto turboModuleProvider =
       [self = this->shared_from_this()](std::string const& moduleName) {
         auto turboModule = self->getTurboModule(moduleName);
+        if (turboModule != nullptr && self->m_warmSet != nullptr) {
+          self->m_warmSet->recordAccess(moduleName);
+        }
         return turboModule;
       };
   runtimeExecutor([turboModuleProvider = std::move(turboModuleProvider)](
@@ -13,6 +13,7 @@
 #include <functional>
 #include "EventDispatcher.h"
 #include "RNOH/TurboModuleFactory.h"
+#include "RNOH/TurboModuleWarmSet.h"
 
 namespace rnoh {
 
@@ -35,6 +36,14 @@ class TurboModuleProvider
     this->m_scheduler = scheduler;
   }
 
+  /**
+   * @brief Makes the warm set record modules accessed from JS. Must be called
+   * before `installJSBindings`.
+   */
+  void setWarmSet(TurboModuleWarmSet::Shared warmSet) {
+    m_warmSet = std::move(warmSet);
+  }
+
  private:
   std::shared_ptr<facebook::react::CallInvoker> m_jsInvoker;
   std::weak_ptr<RNInstance> m_instance;
@@ -47,6 +56,7 @@ class TurboModuleProvider
   std::unordered_map<std::string, std::shared_ptr<facebook::react::TurboModule>>
       m_cache;
   std::shared_ptr<facebook::react::Scheduler> m_scheduler;
+  TurboModuleWarmSet::Shared m_warmSet;
 };
 
 } // namespace rnoh
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "TurboModuleWarmSet.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace rnoh {
+
+TurboModuleWarmSet::TurboModuleWarmSet(
+    std::string filePath,
+    std::chrono::milliseconds recordingDuration)
+    : m_filePath(std::move(filePath)),
+      m_recordingDeadline(
+          std::chrono::steady_clock::now() + recordingDuration) {
+  // one module name per line
+  std::ifstream file(m_filePath);
+  std::string moduleName;
+  while (std::getline(file, moduleName)) {
+    if (!moduleName.empty()) {
+      m_moduleNames.push_back(std::move(moduleName));
+    }
+  }
+  DLOG(INFO) << "Loaded " << m_moduleNames.size()
+             << " Turbo Modules from the warm set " << m_filePath;
+}
+
+std::vector<std::string> const& TurboModuleWarmSet::getModuleNames() const {
+  return m_moduleNames;
+}
+
+void TurboModuleWarmSet::recordAccess(std::string const& moduleName) {
+  if (!m_isRecording) {
+    return;
+  }
+  if (std::chrono::steady_clock::now() > m_recordingDeadline) {
+    finishRecording();
+    return;
+  }
+  auto lock = std::lock_guard(m_mtx);
+  if (m_isRecording && m_recordedModuleNamesSet.insert(moduleName).second) {
+    m_recordedModuleNames.push_back(moduleName);
+  }
+}
+
+std::chrono::milliseconds TurboModuleWarmSet::getRemainingRecordingTime()
+    const {
+  auto remainingTime = m_recordingDeadline - std::chrono::steady_clock::now();
+  return std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(remainingTime),
+      std::chrono::milliseconds(0));
+}
+
+void TurboModuleWarmSet::finishRecording() {
+  auto lock = std::lock_guard(m_mtx);
+  if (!m_isRecording.exchange(false)) {
+    return;
+  }
+  // write to a temporary file first, so a crash doesn't leave a partial list
+  auto tmpFilePath = m_filePath + ".tmp";
+  {
+    std::ofstream file(tmpFilePath, std::ios::trunc);
+    for (auto const& moduleName : m_recordedModuleNames) {
+      file << moduleName << '\n';
+    }
+    if (!file.good()) {
+      LOG(WARNING) << "Couldn't write the Turbo Module warm set to "
+                   << tmpFilePath;
+      return;
+    }
+  }
+  if (std::rename(tmpFilePath.c_str(), m_filePath.c_str()) != 0) {
+    LOG(WARNING) << "Couldn't persist the Turbo Module warm set to "
+                 << m_filePath;
+    return;
+  }
+  DLOG(INFO) << "Persisted " << m_recordedModuleNames.size()
+             << " Turbo Modules to the warm set " << m_filePath;
+}
+
+} // namespace rnoh
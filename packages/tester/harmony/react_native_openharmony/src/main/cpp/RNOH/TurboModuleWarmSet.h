@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * Turbo Modules JS accessed early in the previous session, and a recording of
+ * the ones it accesses early in this one. RN instances create the modules
+ * from the previous session ahead of time, when their JS thread is idle, so
+ * JS doesn't have to wait for them. Other modules are still created on first
+ * access.
+ *
+ * The recording covers accesses from all RN instances during the first
+ * `recordingDuration` after the warm set was created, and is persisted by
+ * `finishRecording`.
+ */
+class TurboModuleWarmSet {
+ public:
+  using Shared = std::shared_ptr<TurboModuleWarmSet>;
+
+  TurboModuleWarmSet(
+      std::string filePath,
+      std::chrono::milliseconds recordingDuration);
+
+  /**
+   * @return modules recorded in the previous session, in the order of their
+   * first access
+   */
+  std::vector<std::string> const& getModuleNames() const;
+
+  void recordAccess(std::string const& moduleName);
+
+  std::chrono::milliseconds getRemainingRecordingTime() const;
+
+  /**
+   * @brief Stops the recording and persists it. Only the first call has an
+   * effect.
+   */
+  void finishRecording();
+
+ private:
+  std::string m_filePath;
+  std::chrono::steady_clock::time_point m_recordingDeadline;
+  std::vector<std::string> m_moduleNames;
+  std::mutex m_mtx;
+  std::atomic_bool m_isRecording = true;
+  std::vector<std::string> m_recordedModuleNames;
+  std::unordered_set<std::string> m_recordedModuleNamesSet;
+};
+
+} // namespace rnoh
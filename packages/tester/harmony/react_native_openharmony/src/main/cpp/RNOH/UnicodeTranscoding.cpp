@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "UnicodeTranscoding.h"
+#include <cstdint>
+#include <cstring>
+
+namespace rnoh {
+
+constexpr char16_t REPLACEMENT_CHARACTER = 0xFFFD;
+constexpr uint64_t NON_ASCII_MASK = 0x8080808080808080;
+
+/**
+ * Returns the length of the ASCII prefix of `bytes`, checking 8 bytes at a
+ * time.
+ */
+static size_t getAsciiPrefixLength(const uint8_t* bytes, size_t size) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    if ((word & NON_ASCII_MASK) != 0) {
+      break;
+    }
+  }
+  while (i < size && bytes[i] < 0x80) {
+    i++;
+  }
+  return i;
+}
+
+static bool isContinuationByte(uint8_t byte) {
+  return (byte & 0xC0) == 0x80;
+}
+
+void appendUtf8AsUtf16(std::string_view utf8, std::u16string& utf16) {
+  auto bytes = reinterpret_cast<const uint8_t*>(utf8.data());
+  auto size = utf8.size();
+  // UTF-16 never needs more code units than UTF-8 needs bytes
+  utf16.reserve(utf16.size() + size);
+  size_t i = 0;
+  while (i < size) {
+    auto asciiLength = getAsciiPrefixLength(bytes + i, size - i);
+    utf16.append(bytes + i, bytes + i + asciiLength);
+    i += asciiLength;
+    if (i == size) {
+      break;
+    }
+
+    uint8_t lead = bytes[i];
+    size_t sequenceLength = 0;
+    uint32_t codePoint = 0;
+    // bounds of the second byte exclude overlong encodings, surrogates and
+    // code points above U+10FFFF
+    uint8_t secondMin = 0x80;
+    uint8_t secondMax = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+      sequenceLength = 2;
+      codePoint = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      sequenceLength = 3;
+      codePoint = lead & 0x0F;
+      secondMin = lead == 0xE0 ? 0xA0 : 0x80;
+      secondMax = lead == 0xED ? 0x9F : 0xBF;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+      sequenceLength = 4;
+      codePoint = lead & 0x07;
+      secondMin = lead == 0xF0 ? 0x90 : 0x80;
+      secondMax = lead == 0xF4 ? 0x8F : 0xBF;
+    } else {
+      utf16.push_back(REPLACEMENT_CHARACTER);
+      i++;
+      continue;
+    }
+
+    size_t consumed = 1;
+    for (; consumed < sequenceLength && i + consumed < size; consumed++) {
+      uint8_t byte = bytes[i + consumed];
+      bool isValid = consumed == 1 ? byte >= secondMin && byte <= secondMax
+                                   : isContinuationByte(byte);
+      if (!isValid) {
+        break;
+      }
+      codePoint = (codePoint << 6) | (byte & 0x3F);
+    }
+    i += consumed;
+    if (consumed < sequenceLength) {
+      // the valid prefix of a truncated sequence is replaced as a whole
+      utf16.push_back(REPLACEMENT_CHARACTER);
+      continue;
+    }
+    if (codePoint < 0x10000) {
+      utf16.push_back(static_cast<char16_t>(codePoint));
+    } else {
+      codePoint -= 0x10000;
+      utf16.push_back(static_cast<char16_t>(0xD800 + (codePoint >> 10)));
+      utf16.push_back(static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF)));
+    }
+  }
+}
+
+void appendUtf16AsUtf8(std::u16string_view utf16, std::string& utf8) {
+  utf8.reserve(utf8.size() + utf16.size());
+  auto size = utf16.size();
+  for (size_t i = 0; i < size; i++) {
+    uint32_t codePoint = utf16[i];
+    if (codePoint < 0x80) {
+      utf8.push_back(static_cast<char>(codePoint));
+      continue;
+    }
+    if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+      bool isPaired = codePoint <= 0xDBFF && i + 1 < size &&
+          utf16[i + 1] >= 0xDC00 && utf16[i + 1] <= 0xDFFF;
+      if (isPaired) {
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) +
+            (utf16[i + 1] - 0xDC00);
+        i++;
+      } else {
+        codePoint = REPLACEMENT_CHARACTER;
+      }
+    }
+    if (codePoint < 0x800) {
+      utf8.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    } else if (codePoint < 0x10000) {
+      utf8.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+      utf8.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    } else {
+      utf8.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+      utf8.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+      utf8.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    }
+    utf8.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+} // namespace rnoh
@@ -0,0 +1,35 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * Appends UTF-8 text to a UTF-16 buffer. Invalid sequences are validated
+ * and replaced with U+FFFD (one per maximal invalid subpart, as recommended
+ * by the Unicode standard) instead of throwing. ASCII runs are copied
+ * several bytes at a time. The buffer isn't cleared, so callers can reuse
+ * its capacity across calls.
+ */
+void appendUtf8AsUtf16(std::string_view utf8, std::u16string& utf16);
+
+/**
+ * @internal
+ * @threadSafe
+ *
+ * Appends UTF-16 text to a UTF-8 buffer. Unpaired surrogates are replaced
+ * with U+FFFD. The buffer isn't cleared.
+ */
+void appendUtf16AsUtf8(std::u16string_view utf16, std::string& utf8);
+
+} // namespace rnoh
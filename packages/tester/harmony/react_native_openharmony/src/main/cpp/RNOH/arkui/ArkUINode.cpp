@@ -155,6 +155,16 @@ static void receiveEvent(ArkUI_NodeEvent* event) {
   }
 }
 
+std::atomic<uint64_t> ArkUINode::s_issuedAttributeWrites{0};
+std::atomic<uint64_t> ArkUINode::s_skippedAttributeWrites{0};
+
+ArkUINode::AttributeWriteStats ArkUINode::getAttributeWriteStats() {
+  return {
+      .issuedWrites = s_issuedAttributeWrites.load(std::memory_order_relaxed),
+      .skippedWrites =
+          s_skippedAttributeWrites.load(std::memory_order_relaxed)};
+}
+
 ArkUINode::ArkUINode(ArkUI_NodeHandle nodeHandle) : m_nodeHandle(nodeHandle) {
   RNOH_ASSERT(nodeHandle != nullptr);
   maybeThrow(NativeNodeApi::getInstance()->addNodeEventReceiver(
@@ -204,8 +214,7 @@ ArkUINode& ArkUINode::setPosition(facebook::react::Point const& position) {
   ArkUI_NumberValue value[] = {
       static_cast<float>(position.x), static_cast<float>(position.y)};
   ArkUI_AttributeItem item = {value, sizeof(value) / sizeof(ArkUI_NumberValue)};
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_POSITION, &item));
+  setAttributeIfChanged(NODE_POSITION, item);
   return *this;
 }
 
@@ -216,8 +225,7 @@ ArkUINode& ArkUINode::setSize(facebook::react::Size const& size) {
   ArkUI_AttributeItem widthItem = {
       widthValue, sizeof(widthValue) / sizeof(ArkUI_NumberValue)};
 
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_WIDTH, &widthItem));
+  setAttributeIfChanged(NODE_WIDTH, widthItem);
 
   // HACK: ArkUI doesn't handle 0-sized views properly
   ArkUI_NumberValue heightValue[] = {
@@ -225,8 +233,7 @@ ArkUINode& ArkUINode::setSize(facebook::react::Size const& size) {
   ArkUI_AttributeItem heightItem = {
       heightValue, sizeof(heightValue) / sizeof(ArkUI_NumberValue)};
 
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_HEIGHT, &heightItem));
+  setAttributeIfChanged(NODE_HEIGHT, heightItem);
   return *this;
 }
 
@@ -248,8 +255,7 @@ ArkUINode& ArkUINode::setHeight(float height) {
   ArkUI_AttributeItem heightItem = {
       heightValue, sizeof(heightValue) / sizeof(ArkUI_NumberValue)};
 
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_HEIGHT, &heightItem));
+  setAttributeIfChanged(NODE_HEIGHT, heightItem);
   return *this;
 }
 
@@ -264,8 +270,7 @@ ArkUINode& ArkUINode::setLayoutRect(
       {.i32 = static_cast<int32_t>(size.height * pointScaleFactor + 0.5)}};
   this->saveSize(value[2].i32, value[3].i32);
   ArkUI_AttributeItem item = {value, sizeof(value) / sizeof(ArkUI_NumberValue)};
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_LAYOUT_RECT, &item));
+  setAttributeIfChanged(NODE_LAYOUT_RECT, item);
   return *this;
 }
 
@@ -283,8 +288,7 @@ ArkUINode& ArkUINode::setWidth(float width) {
   ArkUI_AttributeItem widthItem = {
       widthValue, sizeof(widthValue) / sizeof(ArkUI_NumberValue)};
 
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_WIDTH, &widthItem));
+  setAttributeIfChanged(NODE_WIDTH, widthItem);
   return *this;
 }
 
@@ -304,8 +308,7 @@ ArkUINode& ArkUINode::setBorderWidth(
   ArkUI_AttributeItem borderWidthItem = {
       borderWidthValue, sizeof(borderWidthValue) / sizeof(ArkUI_NumberValue)};
 
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_BORDER_WIDTH, &borderWidthItem));
+  setAttributeIfChanged(NODE_BORDER_WIDTH, borderWidthItem);
   return *this;
 }
 
@@ -336,8 +339,7 @@ ArkUINode& ArkUINode::setBorderColor(
   ArkUI_AttributeItem borderColorItem = {
       borderColorValue, sizeof(borderColorValue) / sizeof(ArkUI_NumberValue)};
 
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_BORDER_COLOR, &borderColorItem));
+  setAttributeIfChanged(NODE_BORDER_COLOR, borderColorItem);
   return *this;
 }
 
@@ -368,8 +370,7 @@ ArkUINode& ArkUINode::setBorderRadius(
   ArkUI_AttributeItem borderRadiusItem = {
       borderRadiusValue, sizeof(borderRadiusValue) / sizeof(ArkUI_NumberValue)};
 
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_BORDER_RADIUS, &borderRadiusItem));
+  setAttributeIfChanged(NODE_BORDER_RADIUS, borderRadiusItem);
   return *this;
 }
 
@@ -388,8 +389,7 @@ ArkUINode& ArkUINode::setBorderStyle(
   ArkUI_AttributeItem borderStyleItem = {
       borderStyleValue, sizeof(borderStyleValue) / sizeof(ArkUI_NumberValue)};
 
-  maybeThrow(NativeNodeApi::getInstance()->setAttribute(
-      m_nodeHandle, NODE_BORDER_STYLE, &borderStyleItem));
+  setAttributeIfChanged(NODE_BORDER_STYLE, borderStyleItem);
   return *this;
 }
 
@@ -933,6 +933,20 @@ void ArkUINode::setAttribute(
       m_nodeHandle, attribute, &item));
 }
 
+void ArkUINode::setAttributeIfChanged(
+    ArkUI_NodeAttributeType attribute,
+    ArkUI_AttributeItem const& item) {
+  if (item.size < 0 || item.string != nullptr || item.object != nullptr) {
+    setAttribute(attribute, item);
+    return;
+  }
+  auto isWritten = m_attributeWriteCache.writeIfChanged(
+      attribute, item.value, item.size, [&] { setAttribute(attribute, item); });
+  auto& counter =
+      isWritten ? s_issuedAttributeWrites : s_skippedAttributeWrites;
+  counter.fetch_add(1, std::memory_order_relaxed);
+}
+
 void ArkUINode::setAttribute(
     ArkUI_NodeAttributeType attribute,
     std::initializer_list<ArkUI_NumberValue> values) {
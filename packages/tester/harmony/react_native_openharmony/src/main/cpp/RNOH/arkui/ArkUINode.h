@@ -19,8 +19,10 @@
 #include <react/renderer/graphics/Float.h>
 #include <react/renderer/graphics/Rect.h>
 #include <react/renderer/graphics/Transform.h>
+#include <atomic>
 #include <initializer_list>
 #include <stdexcept>
+#include "AttributeWriteCache.h"
 #include "glog/logging.h"
 #include "react/renderer/components/view/primitives.h"
 
@@ -92,6 +94,21 @@ class ArkUINode {
 
   using Alignment = ArkUI_Alignment;
 
+  /**
+   * @brief Process-wide counters of numeric attribute writes that go through
+   * the per-node attribute cache (geometry and border attributes).
+   */
+  struct AttributeWriteStats {
+    uint64_t issuedWrites = 0;
+    uint64_t skippedWrites = 0;
+  };
+
+  /**
+   * @brief Returns how many cached attribute writes were sent to ArkUI and how
+   * many were skipped because the value didn't change.
+   */
+  static AttributeWriteStats getAttributeWriteStats();
+
   /**
    * @brief Gets a pointer to the underlying ArkUI_Node
    * @return Handle to the native ArkUI node
@@ -603,10 +620,28 @@ class ArkUINode {
     setAttribute(attribute, item);
   }
 
+  /**
+   * @brief Sets a numeric attribute, skipping the native call if the same
+   * values were the last ones written through this method. Only use it for
+   * attributes that are never written to the node in any other way, otherwise
+   * the cache would get out of sync with the native node.
+   */
+  void setAttributeIfChanged(
+      ArkUI_NodeAttributeType attribute,
+      ArkUI_AttributeItem const& item);
+
   ArkUI_NodeHandle m_nodeHandle;
 
  private:
+  static std::atomic<uint64_t> s_issuedAttributeWrites;
+  static std::atomic<uint64_t> s_skippedAttributeWrites;
+
   int32_t m_measuredWidth = 0;
   int32_t m_measuredHeight = 0;
+  /**
+   * Last values written by setAttributeIfChanged.
+   */
+  AttributeWriteCache<ArkUI_NodeAttributeType, ArkUI_NumberValue, 4>
+      m_attributeWriteCache;
 };
 } // namespace rnoh
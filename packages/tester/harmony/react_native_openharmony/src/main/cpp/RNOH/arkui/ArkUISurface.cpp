@@ -103,6 +103,7 @@ ArkUISurface::ArkUISurface(
                << surfaceId;
     return;
   }
+  m_rootView->setSurfaceId(surfaceId);
   m_componentInstanceRegistry->insert(m_rootView);
   RNOH_ASSERT(arkTSMessageHub != nullptr);
   m_touchEventHandler = std::make_shared<SurfaceTouchEventHandler>(
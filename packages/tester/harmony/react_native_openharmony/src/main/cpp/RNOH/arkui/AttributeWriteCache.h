@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace rnoh {
+
+/**
+ * @internal
+ *
+ * Remembers the values last written for a handful of attributes, so that
+ * writes of unchanged values can be skipped. Doesn't depend on ArkUI: the
+ * write itself is passed in, which lets the skip logic be exercised with a
+ * recording stub in place of NativeNodeApi.
+ */
+template <typename Attribute, typename Value, size_t MaxValues>
+class AttributeWriteCache {
+  static_assert(std::is_trivially_copyable_v<Value>);
+
+ public:
+  /**
+   * @brief Calls `write` unless `values` are the ones last written for
+   * `attribute`. Attributes with more than `MaxValues` values are always
+   * written and never cached.
+   * @return true if `write` was called
+   */
+  template <typename WriteFn>
+  bool writeIfChanged(
+      Attribute attribute,
+      Value const* values,
+      size_t size,
+      WriteFn&& write) {
+    if (size > MaxValues) {
+      write();
+      return true;
+    }
+    auto valuesSizeInBytes = size * sizeof(Value);
+    auto it = std::find_if(
+        m_entries.begin(), m_entries.end(), [attribute](auto const& entry) {
+          return entry.attribute == attribute;
+        });
+    if (it != m_entries.end() && it->size == size &&
+        std::memcmp(it->values.data(), values, valuesSizeInBytes) == 0) {
+      return false;
+    }
+    // drop the old entry before writing, so that a write that throws doesn't
+    // leave a stale entry behind
+    if (it != m_entries.end()) {
+      m_entries.erase(it);
+    }
+    write();
+    Entry entry{.attribute = attribute, .size = size, .values = {}};
+    std::memcpy(entry.values.data(), values, valuesSizeInBytes);
+    m_entries.push_back(entry);
+    return true;
+  }
+
+ private:
+  struct Entry {
+    Attribute attribute{};
+    size_t size = 0;
+    std::array<Value, MaxValues> values{};
+  };
+
+  /**
+   * Only a handful of attributes are cached per node, so a flat vector beats
+   * a hash map here.
+   */
+  std::vector<Entry> m_entries;
+};
+
+} // namespace rnoh
@@ -0,0 +1,235 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <arkui/native_node.h>
+#include <arkui/native_type.h>
+#include "InMemoryNodeTree.h"
+#include "NativeNodeApi.h"
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @thread: MAIN
+ *
+ * A NativeNodeApi backend which keeps the node tree in an InMemoryNodeTree
+ * instead of creating ArkUI nodes, so that the mounting pipeline
+ * (MountingManagerCAPI, CppComponentInstance, ArkUINode) can be benchmarked
+ * and verified without rendering. Header-only, so it's only linked into the
+ * binaries which include it.
+ *
+ * Only the subset of ArkUI_NativeNodeAPI_1 used by RNOH is implemented.
+ * Events are never emitted.
+ */
+class InMemoryNativeNodeApi {
+ public:
+  using Tree = InMemoryNodeTree<ArkUI_NodeType, ArkUI_NumberValue>;
+
+  static InMemoryNativeNodeApi& getInstance() {
+    static InMemoryNativeNodeApi instance;
+    return instance;
+  }
+
+  /**
+   * @brief Makes NativeNodeApi::getInstance() return this backend.
+   */
+  void install() {
+    NativeNodeApi::setInstance(&m_api);
+  }
+
+  /**
+   * @brief Restores the ArkUI backend in NativeNodeApi.
+   */
+  void uninstall() {
+    NativeNodeApi::setInstance(nullptr);
+  }
+
+  Tree& getTree() {
+    return m_tree;
+  }
+
+  static Tree::Node* toNode(ArkUI_NodeHandle handle) {
+    return reinterpret_cast<Tree::Node*>(handle);
+  }
+
+  static ArkUI_NodeHandle toHandle(Tree::Node* node) {
+    return reinterpret_cast<ArkUI_NodeHandle>(node);
+  }
+
+ private:
+  static Tree& tree() {
+    return getInstance().m_tree;
+  }
+
+  static int32_t toErrorCode(bool succeeded) {
+    return succeeded ? ARKUI_ERROR_CODE_NO_ERROR
+                     : ARKUI_ERROR_CODE_PARAM_INVALID;
+  }
+
+  InMemoryNativeNodeApi() {
+    m_api.version = 1;
+    m_api.createNode = [](ArkUI_NodeType type) {
+      return toHandle(tree().createNode(type));
+    };
+    m_api.disposeNode = [](ArkUI_NodeHandle node) {
+      tree().disposeNode(toNode(node));
+    };
+    m_api.addChild = [](ArkUI_NodeHandle parent, ArkUI_NodeHandle child) {
+      return toErrorCode(
+          tree().insertChildAt(toNode(parent), toNode(child), -1));
+    };
+    m_api.insertChildAt =
+        [](ArkUI_NodeHandle parent, ArkUI_NodeHandle child, int32_t position) {
+          return toErrorCode(
+              tree().insertChildAt(toNode(parent), toNode(child), position));
+        };
+    m_api.removeChild = [](ArkUI_NodeHandle parent, ArkUI_NodeHandle child) {
+      return toErrorCode(tree().removeChild(toNode(parent), toNode(child)));
+    };
+    m_api.removeAllChildren = [](ArkUI_NodeHandle parent) {
+      return toErrorCode(tree().removeAllChildren(toNode(parent)));
+    };
+    m_api.setAttribute = [](ArkUI_NodeHandle node,
+                            ArkUI_NodeAttributeType attribute,
+                            const ArkUI_AttributeItem* item) {
+      if (item == nullptr || item->size < 0) {
+        return toErrorCode(false);
+      }
+      return toErrorCode(
+          tree().setAttribute(
+              toNode(node),
+              attribute,
+              item->value,
+              static_cast<size_t>(item->size),
+              item->string,
+              item->object) != nullptr);
+    };
+    // like in ArkUI, the returned item is valid until the next getAttribute
+    m_api.getAttribute =
+        [](ArkUI_NodeHandle node,
+           ArkUI_NodeAttributeType attribute) -> const ArkUI_AttributeItem* {
+      auto recorded = tree().getAttribute(toNode(node), attribute);
+      if (recorded == nullptr) {
+        return nullptr;
+      }
+      auto& item = getInstance().m_lastReadItem;
+      item = {
+          .value = recorded->values.data(),
+          .size = static_cast<int32_t>(recorded->values.size()),
+          .string = recorded->hasString ? recorded->string.c_str() : nullptr,
+          .object = recorded->object};
+      return &item;
+    };
+    m_api.resetAttribute = [](ArkUI_NodeHandle node,
+                              ArkUI_NodeAttributeType attribute) {
+      return toErrorCode(tree().resetAttribute(toNode(node), attribute));
+    };
+    m_api.registerNodeEvent = [](ArkUI_NodeHandle /*node*/,
+                                 ArkUI_NodeEventType /*eventType*/,
+                                 int32_t /*targetId*/,
+                                 void* /*userData*/) -> int32_t {
+      return ARKUI_ERROR_CODE_NO_ERROR;
+    };
+    m_api.unregisterNodeEvent = [](ArkUI_NodeHandle /*node*/,
+                                   ArkUI_NodeEventType /*eventType*/) {};
+    m_api.addNodeEventReceiver =
+        [](ArkUI_NodeHandle /*node*/,
+           void (*/*eventReceiver*/)(ArkUI_NodeEvent*)) -> int32_t {
+      return ARKUI_ERROR_CODE_NO_ERROR;
+    };
+    m_api.removeNodeEventReceiver =
+        [](ArkUI_NodeHandle /*node*/,
+           void (*/*eventReceiver*/)(ArkUI_NodeEvent*)) -> int32_t {
+      return ARKUI_ERROR_CODE_NO_ERROR;
+    };
+    m_api.markDirty = [](ArkUI_NodeHandle node, ArkUI_NodeDirtyFlag flag) {
+      if (tree().contains(toNode(node))) {
+        toNode(node)->dirtyFlags |= static_cast<uint32_t>(flag);
+      }
+    };
+    m_api.getTotalChildCount = [](ArkUI_NodeHandle node) -> uint32_t {
+      return tree().contains(toNode(node)) ? toNode(node)->children.size()
+                                           : 0;
+    };
+    m_api.getChildAt = [](ArkUI_NodeHandle node,
+                          int32_t position) -> ArkUI_NodeHandle {
+      if (!tree().contains(toNode(node))) {
+        return nullptr;
+      }
+      auto const& children = toNode(node)->children;
+      if (position < 0 || static_cast<size_t>(position) >= children.size()) {
+        return nullptr;
+      }
+      return toHandle(children[position]);
+    };
+    m_api.getParent = [](ArkUI_NodeHandle node) -> ArkUI_NodeHandle {
+      return tree().contains(toNode(node)) ? toHandle(toNode(node)->parent)
+                                           : nullptr;
+    };
+    m_api.setMeasuredSize =
+        [](ArkUI_NodeHandle node, int32_t width, int32_t height) -> int32_t {
+      if (!tree().contains(toNode(node))) {
+        return toErrorCode(false);
+      }
+      toNode(node)->measuredWidth = width;
+      toNode(node)->measuredHeight = height;
+      return ARKUI_ERROR_CODE_NO_ERROR;
+    };
+    m_api.getMeasuredSize = [](ArkUI_NodeHandle node) -> ArkUI_IntSize {
+      if (!tree().contains(toNode(node))) {
+        return {};
+      }
+      return {toNode(node)->measuredWidth, toNode(node)->measuredHeight};
+    };
+    m_api.getLayoutPosition = [](ArkUI_NodeHandle node) -> ArkUI_IntOffset {
+      if (!tree().contains(toNode(node))) {
+        return {};
+      }
+      return {toNode(node)->layoutX, toNode(node)->layoutY};
+    };
+    m_api.setUserData = [](ArkUI_NodeHandle node, void* userData) -> int32_t {
+      if (!tree().contains(toNode(node))) {
+        return toErrorCode(false);
+      }
+      toNode(node)->userData = userData;
+      return ARKUI_ERROR_CODE_NO_ERROR;
+    };
+    m_api.getUserData = [](ArkUI_NodeHandle node) -> void* {
+      return tree().contains(toNode(node)) ? toNode(node)->userData : nullptr;
+    };
+    m_api.setLengthMetricUnit = [](ArkUI_NodeHandle /*node*/,
+                                   ArkUI_LengthMetricUnit /*unit*/) -> int32_t {
+      return ARKUI_ERROR_CODE_NO_ERROR;
+    };
+    m_api.registerNodeCustomEvent = [](ArkUI_NodeHandle /*node*/,
+                                       ArkUI_NodeCustomEventType /*eventType*/,
+                                       int32_t /*targetId*/,
+                                       void* /*userData*/) -> int32_t {
+      return ARKUI_ERROR_CODE_NO_ERROR;
+    };
+    m_api.unregisterNodeCustomEvent =
+        [](ArkUI_NodeHandle /*node*/,
+           ArkUI_NodeCustomEventType /*eventType*/) {};
+    m_api.addNodeCustomEventReceiver =
+        [](ArkUI_NodeHandle /*node*/,
+           void (*/*eventReceiver*/)(ArkUI_NodeCustomEvent*)) -> int32_t {
+      return ARKUI_ERROR_CODE_NO_ERROR;
+    };
+    m_api.removeNodeCustomEventReceiver =
+        [](ArkUI_NodeHandle /*node*/,
+           void (*/*eventReceiver*/)(ArkUI_NodeCustomEvent*)) -> int32_t {
+      return ARKUI_ERROR_CODE_NO_ERROR;
+    };
+  }
+
+  ArkUI_NativeNodeAPI_1 m_api{};
+  ArkUI_AttributeItem m_lastReadItem{};
+  Tree m_tree;
+};
+
+} // namespace rnoh
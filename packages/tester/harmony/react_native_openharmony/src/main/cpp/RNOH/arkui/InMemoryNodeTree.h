@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rnoh {
+
+/**
+ * @internal
+ * @thread: MAIN
+ *
+ * A node tree kept in memory: every node records its type, children and the
+ * last value written for each attribute. Doesn't depend on ArkUI, which lets
+ * it be used on the host; InMemoryNativeNodeApi exposes it as an
+ * ArkUI_NativeNodeAPI_1 backend.
+ */
+template <typename NodeType, typename NumberValue>
+class InMemoryNodeTree {
+ public:
+  struct Attribute {
+    std::vector<NumberValue> values;
+    std::string string;
+    bool hasString = false;
+    void* object = nullptr;
+  };
+
+  struct Node {
+    NodeType type{};
+    Node* parent = nullptr;
+    std::vector<Node*> children;
+    std::unordered_map<int32_t, Attribute> attributeByType;
+    void* userData = nullptr;
+    int32_t measuredWidth = 0;
+    int32_t measuredHeight = 0;
+    int32_t layoutX = 0;
+    int32_t layoutY = 0;
+    uint32_t dirtyFlags = 0;
+  };
+
+  struct Stats {
+    uint64_t createdNodes = 0;
+    uint64_t disposedNodes = 0;
+    uint64_t attributeWrites = 0;
+    uint64_t attributeResets = 0;
+    uint64_t childOperations = 0;
+  };
+
+  Node* createNode(NodeType type) {
+    auto node = std::make_unique<Node>();
+    node->type = type;
+    auto rawNode = node.get();
+    m_nodes.emplace(rawNode, std::move(node));
+    m_stats.createdNodes++;
+    return rawNode;
+  }
+
+  /**
+   * @brief Detaches the node from its parent and disposes it. Like in ArkUI,
+   * the children are detached but stay alive.
+   */
+  void disposeNode(Node* node) {
+    if (!contains(node)) {
+      return;
+    }
+    if (node->parent != nullptr) {
+      removeChild(node->parent, node);
+    }
+    for (auto child : node->children) {
+      child->parent = nullptr;
+    }
+    m_nodes.erase(node);
+    m_stats.disposedNodes++;
+  }
+
+  /**
+   * @brief Inserts the child at `position`, detaching it from its previous
+   * parent first. A negative or out of range position appends the child.
+   * @return false if either node isn't alive
+   */
+  bool insertChildAt(Node* parent, Node* child, int32_t position) {
+    if (!contains(parent) || !contains(child)) {
+      return false;
+    }
+    if (child->parent != nullptr) {
+      removeChild(child->parent, child);
+    }
+    auto& children = parent->children;
+    if (position < 0 || static_cast<size_t>(position) >= children.size()) {
+      children.push_back(child);
+    } else {
+      children.insert(children.begin() + position, child);
+    }
+    child->parent = parent;
+    m_stats.childOperations++;
+    return true;
+  }
+
+  /**
+   * @return false if either node isn't alive or `child` isn't a child of
+   * `parent`
+   */
+  bool removeChild(Node* parent, Node* child) {
+    if (!contains(parent) || !contains(child)) {
+      return false;
+    }
+    // searched from the back, since children are usually removed in reverse
+    // order of insertion
+    auto& children = parent->children;
+    auto it = std::find(children.rbegin(), children.rend(), child);
+    if (it == children.rend()) {
+      return false;
+    }
+    children.erase(std::next(it).base());
+    child->parent = nullptr;
+    m_stats.childOperations++;
+    return true;
+  }
+
+  bool removeAllChildren(Node* parent) {
+    if (!contains(parent)) {
+      return false;
+    }
+    for (auto child : parent->children) {
+      child->parent = nullptr;
+    }
+    m_stats.childOperations += parent->children.size();
+    parent->children.clear();
+    return true;
+  }
+
+  /**
+   * @param string nullptr if the attribute has no string value
+   * @return the stored attribute or nullptr if the node isn't alive
+   */
+  Attribute* setAttribute(
+      Node* node,
+      int32_t attributeType,
+      NumberValue const* values,
+      size_t size,
+      char const* string,
+      void* object) {
+    if (!contains(node)) {
+      return nullptr;
+    }
+    auto& attribute = node->attributeByType[attributeType];
+    attribute.values.assign(values, values + size);
+    attribute.hasString = string != nullptr;
+    attribute.string = string != nullptr ? string : "";
+    attribute.object = object;
+    m_stats.attributeWrites++;
+    return &attribute;
+  }
+
+  bool resetAttribute(Node* node, int32_t attributeType) {
+    if (!contains(node)) {
+      return false;
+    }
+    node->attributeByType.erase(attributeType);
+    m_stats.attributeResets++;
+    return true;
+  }
+
+  /**
+   * @return the last value written for the attribute or nullptr if it was
+   * never set, was reset, or the node isn't alive
+   */
+  Attribute const* getAttribute(Node const* node, int32_t attributeType)
+      const {
+    if (!contains(node)) {
+      return nullptr;
+    }
+    auto it = node->attributeByType.find(attributeType);
+    return it != node->attributeByType.end() ? &it->second : nullptr;
+  }
+
+  /**
+   * @return true if the node was created by this tree and isn't disposed
+   */
+  bool contains(Node const* node) const {
+    return node != nullptr && m_nodes.count(const_cast<Node*>(node)) > 0;
+  }
+
+  /**
+   * @brief Disposes all nodes and clears the stats.
+   */
+  void reset() {
+    m_nodes.clear();
+    m_stats = {};
+  }
+
+  Stats const& getStats() const {
+    return m_stats;
+  }
+
+  size_t getLiveNodeCount() const {
+    return m_nodes.size();
+  }
+
+ private:
+  std::unordered_map<Node*, std::unique_ptr<Node>> m_nodes;
+  Stats m_stats;
+};
+
+} // namespace rnoh
@@ -10,7 +10,12 @@
 
 namespace rnoh {
 
+static ArkUI_NativeNodeAPI_1* OVERRIDDEN_INSTANCE = nullptr;
+
 ArkUI_NativeNodeAPI_1* NativeNodeApi::getInstance() {
+  if (OVERRIDDEN_INSTANCE != nullptr) {
+    return OVERRIDDEN_INSTANCE;
+  }
   static ArkUI_NativeNodeAPI_1* INSTANCE = nullptr;
   if (INSTANCE == nullptr) {
     OH_ArkUI_GetModuleInterface(
@@ -22,4 +27,8 @@ ArkUI_NativeNodeAPI_1* NativeNodeApi::getInstance() {
   return INSTANCE;
 }
 
+void NativeNodeApi::setInstance(ArkUI_NativeNodeAPI_1* api) {
+  OVERRIDDEN_INSTANCE = api;
+}
+
 } // namespace rnoh
\ No newline at end of file
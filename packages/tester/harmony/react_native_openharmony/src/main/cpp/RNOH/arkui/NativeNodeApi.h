@@ -31,6 +31,15 @@ class NativeNodeApi {
    */
   static ArkUI_NativeNodeAPI_1* getInstance();
 
+  /**
+   * @brief Replaces the API returned by getInstance with a custom backend,
+   * e.g. InMemoryNativeNodeApi. Must be called before any ArkUINode is
+   * created. Passing nullptr restores the ArkUI implementation.
+   *
+   * @param api Backend to be used by all subsequent node operations.
+   */
+  static void setInstance(ArkUI_NativeNodeAPI_1* api);
+
  private:
   NativeNodeApi() {}
 
@@ -6,13 +6,16 @@
  */
 
 #include <cxxreact/JSExecutor.h>
+#include <folly/json.h>
 #include <js_native_api.h>
 #include <js_native_api_types.h>
 #include <jsinspector-modern/InspectorFlags.h>
 #include <array>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 #include "RNInstanceFactory.h"
@@ -29,8 +32,10 @@
 #include "RNOH/RNInstance.h"
 #include "RNOH/RNInstanceCAPI.h"
 #include "RNOH/RNInstanceInternal.h"
+#include "RNOH/RNInstancePool.h"
 #include "RNOH/Result.h"
 #include "RNOH/TaskExecutor/NapiTaskRunner.h"
+#include "RNOH/TaskExecutor/SharedThreadTaskRunner.h"
 #include "RNOH/TaskExecutor/ThreadTaskRunner.h"
 #include "RNOH/UITicker.h"
 
@@ -84,6 +89,43 @@ std::unordered_map<size_t, std::shared_ptr<InspectorHostTarget>>
 
 std::unordered_map<int, ArkTSBridge::Shared> ARK_TS_BRIDGE_BY_ENV_ID;
 
+/**
+ * An instance only uses a prewarmed JS runtime which was created with the
+ * same JS engine options and the same kind of JS thread as the instance.
+ */
+struct RNInstancePoolKey {
+  int envId;
+  std::string jsvmInitOptions;
+  bool isJSThreadShared;
+
+  bool operator<(RNInstancePoolKey const& other) const {
+    return std::tie(envId, jsvmInitOptions, isJSThreadShared) <
+        std::tie(other.envId, other.jsvmInitOptions, other.isJSThreadShared);
+  }
+};
+
+std::map<RNInstancePoolKey, RNInstancePool::Shared> RN_INSTANCE_POOL_BY_KEY;
+
+TurboModuleWarmSet::Shared TURBO_MODULE_WARM_SET = nullptr;
+
+// JS thread of instances created with the SHARED_JS_THREAD_ENABLED flag, kept
+// for the lifetime of the process
+SharedTaskThread::Shared SHARED_JS_THREAD = nullptr;
+
+std::unique_ptr<AbstractTaskRunner> createSharedJSTaskRunner() {
+#if USE_HERMES
+  if (SHARED_JS_THREAD == nullptr) {
+    SHARED_JS_THREAD = std::make_shared<SharedTaskThread>("RNOH_JS_SHARED");
+  }
+  return SHARED_JS_THREAD->createTaskRunner();
+#else
+  // JSVM keeps the VM and env scopes of a runtime open on its thread
+  LOG(WARNING) << "Sharing the JS thread isn't supported by JSVM, "
+                  "using a dedicated JS thread instead";
+  return nullptr;
+#endif
+}
+
 std::unordered_map<int, std::pair<NapiRef, napi_env>>
     WORKER_TURBO_MODULE_PROVIDER_REF_AND_ENV_BY_RN_INSTANCE_ID;
 std::unordered_map<int, std::unique_ptr<NapiTaskRunner>>
@@ -135,6 +177,7 @@ static napi_value onInit(napi_env env, napi_callback_info info) {
         instances.clear();
       });
       ARK_TS_BRIDGE_BY_ENV_ID.clear();
+      RN_INSTANCE_POOL_BY_KEY.clear();
     }
     auto isDebugModeEnabled = false;
 #ifdef REACT_NATIVE_DEBUG
@@ -268,6 +311,70 @@ static napi_value resumeDebugger(napi_env env, napi_callback_info info) {
   });
 }
 
+std::shared_ptr<facebook::react::JSRuntimeFactory> createJSEngineProvider(
+    ArkJS& arkJS,
+    napi_value jsvmInitOptions) {
+#if USE_HERMES
+  DLOG(INFO) << "Using HermesInstance";
+  return std::make_shared<JSEngineProvider<facebook::react::HermesInstance>>(
+      std::make_shared<facebook::react::EmptyReactNativeConfig>());
+#else
+  DLOG(INFO) << "Using JSVMInstance";
+  return std::make_shared<JSEngineProvider<jsvm::JSVMInstance>>(
+      std::make_shared<facebook::react::EmptyReactNativeConfig>(),
+      arkJS.getDynamic(jsvmInitOptions));
+#endif
+}
+
+/**
+ * Keeps `count` JS runtimes of the env prewarmed, so that following
+ * onCreateRNInstance calls with the same JSVM init options and shared JS
+ * thread setting don't need to create them.
+ */
+static napi_value prewarmRNInstances(napi_env env, napi_callback_info info) {
+  return invoke(env, [&] {
+    ArkJS arkJS(env);
+    auto args = arkJS.getCallbackArgs(info, 5);
+    int envId = arkJS.getDouble(args[0]);
+    size_t count = arkJS.getDouble(args[1]);
+    bool isJSThreadShared = arkJS.getBoolean(args[4]);
+    auto& pool = RN_INSTANCE_POOL_BY_KEY[RNInstancePoolKey{
+        envId, folly::toJson(arkJS.getDynamic(args[2])), isJSThreadShared}];
+    if (pool == nullptr) {
+      pool = std::make_shared<RNInstancePool>(
+          env,
+          createJSEngineProvider(arkJS, args[2]),
+          arkJS.getString(args[3]),
+          isJSThreadShared ? createSharedJSTaskRunner
+                           : RNInstancePool::JSTaskRunnerFactory{});
+    }
+    pool->resize(count);
+    return arkJS.getNull();
+  });
+}
+
+/**
+ * Makes RN instances create Turbo Modules recorded in the previous session
+ * ahead of time, and record the ones accessed during the first
+ * `recordingDurationMs` of this one. Applies to RN instances created
+ * afterwards.
+ */
+static napi_value configureTurboModuleWarmSet(
+    napi_env env,
+    napi_callback_info info) {
+  return invoke(env, [&] {
+    ArkJS arkJS(env);
+    auto args = arkJS.getCallbackArgs(info, 2);
+    if (TURBO_MODULE_WARM_SET == nullptr) {
+      TURBO_MODULE_WARM_SET = std::make_shared<TurboModuleWarmSet>(
+          arkJS.getString(args[0]),
+          std::chrono::milliseconds(
+              static_cast<int64_t>(arkJS.getDouble(args[1]))));
+    }
+    return arkJS.getNull();
+  });
+}
+
 static napi_value onCreateRNInstance(napi_env env, napi_callback_info info) {
   return invoke(env, [&] {
     ArkJS arkJS(env);
@@ -311,8 +418,29 @@ static napi_value onCreateRNInstance(napi_env env, napi_callback_info info) {
         WORKER_TURBO_MODULE_PROVIDER_REF_AND_ENV_BY_RN_INSTANCE_ID,
         rnInstanceId,
         std::make_pair(NapiRef{}, nullptr));
-    auto taskExecutor =
-        std::make_shared<TaskExecutor>(env, std::move(workerTaskRunner));
+    bool isJSThreadShared =
+        featureFlagRegistry->isFeatureFlagOn("SHARED_JS_THREAD_ENABLED");
+    auto pool = getOrDefault(
+        RN_INSTANCE_POOL_BY_KEY,
+        RNInstancePoolKey{
+            envId, folly::toJson(arkJS.getDynamic(args[11])), isJSThreadShared},
+        nullptr);
+    auto prewarmedInstance =
+        pool != nullptr ? pool->acquire() : std::nullopt;
+    TaskExecutor::Shared taskExecutor = nullptr;
+    if (prewarmedInstance.has_value()) {
+      taskExecutor = prewarmedInstance->taskExecutor;
+      if (workerTaskRunner != nullptr) {
+        taskExecutor->setWorkerTaskRunner(std::move(workerTaskRunner));
+      }
+    } else {
+      std::unique_ptr<AbstractTaskRunner> jsTaskRunner = nullptr;
+      if (isJSThreadShared) {
+        jsTaskRunner = createSharedJSTaskRunner();
+      }
+      taskExecutor = std::make_shared<TaskExecutor>(
+          env, std::move(workerTaskRunner), std::move(jsTaskRunner));
+    }
 
     auto instanceArkTSChannelTaskRunner =
         std::make_shared<NapiTaskRunner>("INSTANCE_ARK_TS_CHANNEL", env);
@@ -327,18 +455,7 @@ static napi_value onCreateRNInstance(napi_env env, napi_callback_info info) {
         std::make_unique<RNInstanceInternal::RNInstanceRNOHMarkerListener>(
             arkTSChannel);
     RNOHMarker::logMarker(RNOHMarker::RNOHMarkerId::APP_STARTUP_START);
-#if USE_HERMES
-    DLOG(INFO) << "Using HermesInstance";
-    auto jsEngineProvider =
-        std::make_shared<JSEngineProvider<facebook::react::HermesInstance>>(
-            std::make_shared<facebook::react::EmptyReactNativeConfig>());
-#else
-    DLOG(INFO) << "Using JSVMInstance";
-    auto jsEngineProvider =
-        std::make_shared<JSEngineProvider<jsvm::JSVMInstance>>(
-            std::make_shared<facebook::react::EmptyReactNativeConfig>(),
-            arkJS.getDynamic(args[11]));
-#endif
+    auto jsEngineProvider = createJSEngineProvider(arkJS, args[11]);
     auto rnInstance = createRNInstance(
         rnInstanceId,
         env,
@@ -406,6 +523,14 @@ static napi_value onCreateRNInstance(napi_env env, napi_callback_info info) {
       LOG(FATAL) << "RNInstance with the following id "
                  << std::to_string(rnInstanceId) << " has been already created";
     }
+    if (prewarmedInstance.has_value()) {
+      rnInstance->setPrewarmedJSRuntime(
+          std::move(prewarmedInstance->jsQueue),
+          std::move(prewarmedInstance->jsRuntime));
+    }
+    if (TURBO_MODULE_WARM_SET != nullptr) {
+      rnInstance->setTurboModuleWarmSet(TURBO_MODULE_WARM_SET);
+    }
     auto [it, _inserted] =
         RN_INSTANCE_BY_ID.emplace(rnInstanceId, std::move(rnInstance));
     it->second->start();
@@ -483,6 +608,23 @@ static napi_value loadScript(napi_env env, napi_callback_info info) {
   });
 }
 
+static napi_value registerSegment(napi_env env, napi_callback_info info) {
+  return invoke(env, [&] {
+    DLOG(INFO) << "registerSegment";
+    ArkJS arkJS(env);
+    auto args = arkJS.getCallbackArgs(info, 3);
+    size_t instanceId = arkJS.getDouble(args[0]);
+    auto rnInstance = maybeGetInstanceById(instanceId);
+    if (!rnInstance) {
+      return arkJS.getUndefined();
+    }
+    rnInstance->registerSegment(
+        static_cast<uint32_t>(arkJS.getDouble(args[1])),
+        arkJS.getString(args[2]));
+    return arkJS.getNull();
+  });
+}
+
 static napi_value updateSurfaceConstraints(
     napi_env env,
     napi_callback_info info) {
@@ -881,6 +1023,22 @@ static napi_value Init(napi_env env, napi_value exports) {
        nullptr,
        napi_default,
        nullptr},
+      {"prewarmRNInstances",
+       nullptr,
+       prewarmRNInstances,
+       nullptr,
+       nullptr,
+       nullptr,
+       napi_default,
+       nullptr},
+      {"configureTurboModuleWarmSet",
+       nullptr,
+       configureTurboModuleWarmSet,
+       nullptr,
+       nullptr,
+       nullptr,
+       napi_default,
+       nullptr},
       {"onCreateRNInstance",
        nullptr,
        onCreateRNInstance,
@@ -905,6 +1063,14 @@ static napi_value Init(napi_env env, napi_value exports) {
        nullptr,
        napi_default,
        nullptr},
+      {"registerSegment",
+       nullptr,
+       registerSegment,
+       nullptr,
+       nullptr,
+       nullptr,
+       napi_default,
+       nullptr},
       {"startSurface",
        nullptr,
        startSurface,
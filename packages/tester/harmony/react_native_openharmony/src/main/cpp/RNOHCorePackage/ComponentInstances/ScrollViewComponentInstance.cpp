@@ -12,6 +12,7 @@
 #include <cmath>
 #include <optional>
 #include "PullToRefreshViewComponentInstance.h"
+#include "RNOH/ContinuousEventStats.h"
 #include "RNOH/arkui/UIInputEventHandler.h"
 #include "ViewComponentInstance.h"
 #include "conversions.h"
@@ -154,6 +155,7 @@ void ScrollViewComponentInstance::onEmitOnScrollEvent() {
             << ", " << scrollViewMetrics.containerSize.height << ")";
     if (m_eventEmitter) {
       m_eventEmitter->onScroll(scrollViewMetrics);
+      ContinuousEventStats::recordEmittedEvent();
     }
     m_currentOffset = scrollViewMetrics.contentOffset;
     m_currentOffset.x = adjustOffsetIfRTL(m_currentOffset.x);
@@ -739,8 +741,18 @@ void rnoh::ScrollViewComponentInstance::sendEventForNativeAnimations(
     m_nativeAnimatedTurboModule = nativeAnimatedTurboModule;
   }
   if (nativeAnimatedTurboModule != nullptr) {
+    // the payload is built only if some Animated.event is mapped to it
+    std::optional<folly::dynamic> payload;
     nativeAnimatedTurboModule->handleComponentEvent(
-        m_tag, "onScroll", getScrollEventPayload(scrollViewMetrics));
+        m_tag,
+        "onScroll",
+        [&](EventAnimationDriver::EventPath const& eventPath) {
+          if (!payload.has_value()) {
+            payload = getScrollEventPayload(scrollViewMetrics);
+          }
+          return EventAnimationDriver::getEventValue(
+              payload.value(), eventPath);
+        });
   }
 }
 
@@ -131,7 +131,10 @@ void AnimatedNodesManager::addAnimatedEventToView(
   for (auto& key : dynamicNativeEventPath) {
     nativeEventPath.push_back(key.asString());
   }
-  m_eventDrivers.push_back(std::make_unique<EventAnimationDriver>(
+  auto [it, _] = m_eventNameIdByName.try_emplace(
+      eventName, static_cast<EventNameId>(m_eventNameIdByName.size()));
+  auto key = makeEventDriversKey(viewTag, it->second);
+  m_eventDriversByKey[key].push_back(std::make_unique<EventAnimationDriver>(
       eventName, viewTag, std::move(nativeEventPath), nodeTag, *this));
 }
 
@@ -139,16 +142,47 @@ void AnimatedNodesManager::removeAnimatedEventFromView(
     facebook::react::Tag viewTag,
     std::string const& eventName,
     facebook::react::Tag animatedValueTag) {
-  m_eventDrivers.erase(
+  auto key = findEventDriversKey(viewTag, eventName);
+  if (!key.has_value()) {
+    return;
+  }
+  auto it = m_eventDriversByKey.find(key.value());
+  if (it == m_eventDriversByKey.end()) {
+    return;
+  }
+  auto& eventDrivers = it->second;
+  eventDrivers.erase(
       std::remove_if(
-          m_eventDrivers.begin(),
-          m_eventDrivers.end(),
+          eventDrivers.begin(),
+          eventDrivers.end(),
           [&](auto& driver) {
-            return driver->getViewTag() == viewTag &&
-                driver->getEventName() == eventName &&
-                driver->getNodeTag() == animatedValueTag;
+            return driver->getNodeTag() == animatedValueTag;
           }),
-      m_eventDrivers.end());
+      eventDrivers.end());
+  if (eventDrivers.empty()) {
+    m_eventDriversByKey.erase(it);
+  }
+}
+
+auto AnimatedNodesManager::findEventDriversKey(
+    facebook::react::Tag viewTag,
+    std::string const& eventName) const -> std::optional<EventDriversKey> {
+  auto it = m_eventNameIdByName.find(eventName);
+  if (it == m_eventNameIdByName.end()) {
+    return std::nullopt;
+  }
+  return makeEventDriversKey(viewTag, it->second);
+}
+
+auto AnimatedNodesManager::makeEventDriversKey(
+    facebook::react::Tag viewTag,
+    EventNameId eventNameId) -> EventDriversKey {
+  return (static_cast<EventDriversKey>(static_cast<uint32_t>(viewTag)) << 32) |
+      eventNameId;
+}
+
+bool AnimatedNodesManager::hasEventDrivers() const {
+  return !m_eventDriversByKey.empty();
 }
 
 void AnimatedNodesManager::startListeningToAnimatedNodeValue(
@@ -167,22 +201,33 @@ void AnimatedNodesManager::stopListeningToAnimatedNodeValue(
 PropUpdatesList AnimatedNodesManager::handleEvent(
     facebook::react::Tag targetTag,
     std::string const& eventName,
-    folly::dynamic const& eventValue) {
-  bool someDriverNeedsUpdate = false;
-  for (auto& driver : m_eventDrivers) {
-    if (driver->getViewTag() == targetTag &&
-        driver->getEventName() == eventName) {
-      someDriverNeedsUpdate = true;
-      driver->updateWithEvent(eventValue);
-    }
+    EventAnimationDriver::EventValueGetter const& getEventValue) {
+  auto key = findEventDriversKey(targetTag, eventName);
+  if (!key.has_value()) {
+    return {};
   }
-
-  if (someDriverNeedsUpdate) {
-    // NOTE: we don't update frame-based drivers here, only the newly-dirty ones
-    // from the event
-    return updateNodes();
+  auto it = m_eventDriversByKey.find(key.value());
+  if (it == m_eventDriversByKey.end()) {
+    return {};
+  }
+  for (auto& driver : it->second) {
+    driver->updateWithEvent(getEventValue);
   }
-  return {};
+  // NOTE: we don't update frame-based drivers here, only the newly-dirty ones
+  // from the event
+  return updateNodes();
+}
+
+PropUpdatesList AnimatedNodesManager::handleEvent(
+    facebook::react::Tag targetTag,
+    std::string const& eventName,
+    folly::dynamic const& eventValue) {
+  return handleEvent(
+      targetTag,
+      eventName,
+      [&eventValue](EventAnimationDriver::EventPath const& eventPath) {
+        return EventAnimationDriver::getEventValue(eventValue, eventPath);
+      });
 }
 
 void AnimatedNodesManager::setValue(facebook::react::Tag tag, double value) {
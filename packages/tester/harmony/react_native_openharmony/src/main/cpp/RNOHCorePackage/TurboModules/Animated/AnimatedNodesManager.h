@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <optional>
 #include <unordered_map>
 
 #include <folly/dynamic.h>
@@ -87,15 +88,38 @@ class AnimatedNodesManager {
 
   void setNeedsUpdate(facebook::react::Tag nodeTag);
 
+  /**
+   * @brief Updates the value nodes driven by the event. Only the numbers
+   * the event drivers are mapped to are read from the payload.
+   */
+  PropUpdatesList handleEvent(
+      facebook::react::Tag targetTag,
+      std::string const& eventName,
+      EventAnimationDriver::EventValueGetter const& getEventValue);
+
   PropUpdatesList handleEvent(
       facebook::react::Tag targetTag,
       std::string const& eventName,
       folly::dynamic const& eventValue);
 
+  bool hasEventDrivers() const;
+
   AnimatedNode& getNodeByTag(facebook::react::Tag tag);
   ValueAnimatedNode& getValueNodeByTag(facebook::react::Tag tag);
 
  private:
+  using EventNameId = uint32_t;
+  // (view tag, interned event name)
+  using EventDriversKey = uint64_t;
+
+  static EventDriversKey makeEventDriversKey(
+      facebook::react::Tag viewTag,
+      EventNameId eventNameId);
+
+  std::optional<EventDriversKey> findEventDriversKey(
+      facebook::react::Tag viewTag,
+      std::string const& eventName) const;
+
   PropUpdatesList updateNodes();
   void stopAnimationsForNode(facebook::react::Tag tag);
   void maybeStartAnimations();
@@ -109,7 +133,12 @@ class AnimatedNodesManager {
       m_nodeByTag;
   std::unordered_map<facebook::react::Tag, std::unique_ptr<AnimationDriver>>
       m_animationById;
-  std::vector<std::unique_ptr<EventAnimationDriver>> m_eventDrivers;
+  // event names are never forgotten, as few distinct names are used
+  std::unordered_map<std::string, EventNameId> m_eventNameIdByName;
+  std::unordered_map<
+      EventDriversKey,
+      std::vector<std::unique_ptr<EventAnimationDriver>>>
+      m_eventDriversByKey;
   std::unordered_set<facebook::react::Tag> m_nodeTagsToUpdate;
   bool m_isRunningAnimations = false;
   DisplayMetricsManager::Shared m_displayMetricsManager;
@@ -6,6 +6,7 @@
  */
 
 #include "EventAnimationDriver.h"
+#include <glog/logging.h>
 #include "RNOHCorePackage/TurboModules/Animated/AnimatedNodesManager.h"
 
 namespace rnoh {
@@ -22,16 +23,37 @@ EventAnimationDriver::EventAnimationDriver(
       m_nodeTag(nodeTag),
       m_nodesManager(nodesManager) {}
 
-void EventAnimationDriver::updateWithEvent(folly::dynamic const& event) {
+std::optional<double> EventAnimationDriver::getEventValue(
+    folly::dynamic const& event,
+    EventPath const& eventPath) {
   auto currentEvent = &event;
-  for (auto& key : m_eventPath) {
-    currentEvent = &(*currentEvent)[key];
+  for (auto& key : eventPath) {
+    if (!currentEvent->isObject()) {
+      return std::nullopt;
+    }
+    auto it = currentEvent->find(key);
+    if (it == currentEvent->items().end()) {
+      return std::nullopt;
+    }
+    currentEvent = &it->second;
   }
+  if (!currentEvent->isNumber()) {
+    return std::nullopt;
+  }
+  return currentEvent->asDouble();
+}
 
+void EventAnimationDriver::updateWithEvent(
+    EventValueGetter const& getEventValue) {
+  auto value = getEventValue(m_eventPath);
+  if (!value.has_value()) {
+    DLOG(WARNING) << "No number in the payload of the " << m_eventName
+                  << " event of view " << m_viewTag;
+    return;
+  }
   auto& valueNode = getValueNode();
-  valueNode.setValue(currentEvent->asDouble());
+  valueNode.setValue(value.value());
   m_nodesManager.setNeedsUpdate(m_nodeTag);
-  return;
 }
 
 ValueAnimatedNode& EventAnimationDriver::getValueNode() const {
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <functional>
+#include <optional>
 #include "RNOHCorePackage/TurboModules/Animated/Nodes/ValueAnimatedNode.h"
 
 namespace rnoh {
@@ -18,6 +20,14 @@ class EventAnimationDriver {
   // a list of property names of the event payload (sub)objects
   // to traverse to get to the value
   using EventPath = std::vector<std::string>;
+  // returns the number at the given path of the event payload, if any, so
+  // that payloads don't have to be converted as a whole
+  using EventValueGetter =
+      std::function<std::optional<double>(EventPath const&)>;
+
+  static std::optional<double> getEventValue(
+      folly::dynamic const& event,
+      EventPath const& eventPath);
 
   EventAnimationDriver(
       std::string const& eventName,
@@ -26,7 +36,7 @@ class EventAnimationDriver {
       facebook::react::Tag nodeTag,
       AnimatedNodesManager& nodesManager);
 
-  void updateWithEvent(folly::dynamic const& event);
+  void updateWithEvent(EventValueGetter const& getEventValue);
 
   ValueAnimatedNode& getValueNode() const;
 
@@ -9,6 +9,8 @@
 #include "RNOH/ArkTSBridge.h"
 
 #include <jsi/jsi/JSIDynamic.h>
+#include <algorithm>
+#include <cstring>
 #include "AnimatedNodesManager.h"
 #include "RNOH/RNInstance.h"
 #include "RNOH/RNInstanceCAPI.h"
@@ -65,12 +67,28 @@ jsi::Value getValue(
     size_t count) {
   auto self = static_cast<NativeAnimatedTurboModule*>(&turboModule);
   auto tag = args[0].getNumber();
-  auto value = self->getValue(tag);
   if (count > 1) {
-    args[1].getObject(rt).getFunction(rt).call(rt, value);
+    auto callbackWrapped = self->createCallbackWrapper(
+        std::move(args[1].getObject(rt).getFunction(rt)), rt);
+    self->getValue(
+        tag,
+        [jsInvoker = self->jsInvoker_,
+         &rt,
+         callbackWrapped = std::move(callbackWrapped)](double value) {
+          jsInvoker->invokeAsync([&rt, callbackWrapped, value] {
+            auto callback = callbackWrapped.lock();
+            if (callback == nullptr) {
+              return;
+            }
+            callback->callback().call(rt, value);
+            callback->allowRelease();
+          });
+        });
     return facebook::jsi::Value::undefined();
   }
-  self->emitAnimationGetValueEvent(rt, tag, value);
+  self->getValue(tag, [self, &rt, tag](double value) {
+    self->emitAnimationGetValueEvent(rt, tag, value);
+  });
   return facebook::jsi::Value::undefined();
 }
 
@@ -80,7 +98,18 @@ jsi::Value startListeningToAnimatedNodeValue(
     const facebook::jsi::Value* args,
     size_t count) {
   auto self = static_cast<NativeAnimatedTurboModule*>(&turboModule);
-  self->startListeningToAnimatedNodeValue(rt, args[0].getNumber());
+  AnimatedValueListenerOptions options;
+  if (count > 1 && args[1].isObject()) {
+    auto config = args[1].getObject(rt);
+    auto batched = config.getProperty(rt, "batched");
+    options.batched = batched.isBool() && batched.getBool();
+    auto throttleIntervalMs = config.getProperty(rt, "throttleIntervalMs");
+    if (throttleIntervalMs.isNumber()) {
+      options.throttleInterval =
+          std::chrono::milliseconds(int64_t(throttleIntervalMs.getNumber()));
+    }
+  }
+  self->startListeningToAnimatedNodeValue(rt, args[0].getNumber(), options);
   return facebook::jsi::Value::undefined();
 }
 
@@ -291,6 +320,7 @@ void NativeAnimatedTurboModule::setDisplaySoloistFrameRate(int32_t frameRate) {
 }
 
 void NativeAnimatedTurboModule::stopDisplaySoloist() {
+  auto lock = std::lock_guard(m_displaySoloistLock);
   if (isDisplaySoloistRegistered()) {
     int stopStatus = OH_DisplaySoloist_Stop(m_nativeDisplaySoloist.get());
     if (stopStatus != 0) {
@@ -304,6 +334,7 @@ void NativeAnimatedTurboModule::stopDisplaySoloist() {
 }
 
 void NativeAnimatedTurboModule::startDisplaySoloist() {
+  auto lock = std::lock_guard(m_displaySoloistLock);
   if (isDisplaySoloistRegistered()) {
     return;
   }
@@ -338,6 +369,7 @@ jsi::Value queueAndExecuteBatchedOperations(
   }
   auto self = static_cast<NativeAnimatedTurboModule*>(&turboModule);
   auto opsAndArgs = args[0].getObject(rt).getArray(rt);
+  self->startOperationBatch();
 
   for (size_t i = 0; i < opsAndArgs.size(rt);) {
     auto command =
@@ -356,9 +388,13 @@ jsi::Value queueAndExecuteBatchedOperations(
             opsAndArgs.getValueAtIndex(rt, i++).asNumber(),
             opsAndArgs.getValueAtIndex(rt, i++));
         break;
-      case NativeAnimatedTurboModule::BatchExecutionOpCodes::OP_CODE_GET_VALUE:
-        self->getValue(opsAndArgs.getValueAtIndex(rt, i++).asNumber());
-        break;
+      case NativeAnimatedTurboModule::BatchExecutionOpCodes::
+          OP_CODE_GET_VALUE: {
+        auto tag = opsAndArgs.getValueAtIndex(rt, i++).asNumber();
+        self->getValue(tag, [self, &rt, tag](double value) {
+          self->emitAnimationGetValueEvent(rt, tag, value);
+        });
+      } break;
       case NativeAnimatedTurboModule::BatchExecutionOpCodes::
           OP_START_LISTENING_TO_ANIMATED_NODE_VALUE: {
         self->startListeningToAnimatedNodeValue(
@@ -462,6 +498,7 @@ jsi::Value queueAndExecuteBatchedOperations(
         break;
     }
   }
+  self->finishOperationBatch();
   return facebook::jsi::Value::undefined();
 }
 
@@ -478,7 +515,13 @@ NativeAnimatedTurboModule::NativeAnimatedTurboModule(
             this->setDisplaySoloistFrameRate(frameRate);
           },
           [this]() { this->startDisplaySoloist(); },
-          [this]() { this->stopDisplaySoloist(); },
+          [this]() {
+            // throttled values are delivered on one of the next frames, even
+            // if nothing is animating anymore
+            if (!this->hasPendingBatchedValues()) {
+              this->stopDisplaySoloist();
+            }
+          },
           m_ctx.displayMetricsManager) {
   methodMap_ = {
       {"startOperationBatch", {0, rnoh::startOperationBatch}},
@@ -516,64 +559,124 @@ NativeAnimatedTurboModule::~NativeAnimatedTurboModule() {
   }
 }
 
-void NativeAnimatedTurboModule::startOperationBatch() {}
+void NativeAnimatedTurboModule::startOperationBatch() {
+  m_isBatchingOperations = true;
+}
 
-void NativeAnimatedTurboModule::finishOperationBatch() {}
+void NativeAnimatedTurboModule::finishOperationBatch() {
+  m_isBatchingOperations = false;
+  flushOperationBatch();
+}
+
+void NativeAnimatedTurboModule::enqueueOperation(Operation&& operation) {
+  m_operationBatch.push_back(std::move(operation));
+  if (!m_isBatchingOperations) {
+    flushOperationBatch();
+  }
+}
+
+void NativeAnimatedTurboModule::flushOperationBatch() {
+  if (m_operationBatch.empty()) {
+    return;
+  }
+  m_operationBatches.push(std::move(m_operationBatch));
+  m_operationBatch = {};
+  // the frame callback applies the batch
+  startDisplaySoloist();
+}
+
+void NativeAnimatedTurboModule::applyOperationBatches() {
+  while (auto operationBatch = m_operationBatches.pop()) {
+    for (auto& operation : operationBatch.value()) {
+      try {
+        operation(m_animatedNodesManager);
+      } catch (std::exception& e) {
+        LOG(ERROR) << "Error in animated operation: " << e.what();
+      }
+    }
+  }
+  m_hasEventDrivers = m_animatedNodesManager.hasEventDrivers();
+}
 
 void NativeAnimatedTurboModule::createAnimatedNode(
     react::Tag tag,
     folly::dynamic const& config) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.createNode(tag, config);
+  enqueueOperation([tag, config](auto& animatedNodesManager) {
+    animatedNodesManager.createNode(tag, config);
+  });
 }
 
 void NativeAnimatedTurboModule::updateAnimatedNodeConfig(
     react::Tag tag,
     const jsi::Value& config) {}
 
-double NativeAnimatedTurboModule::getValue(react::Tag tag) {
-  auto lock = acquireLock();
-  auto output = m_animatedNodesManager.getNodeOutput(tag);
-  RNOH_ASSERT(output.isDouble());
-  return output.asDouble();
+void NativeAnimatedTurboModule::getValue(
+    react::Tag tag,
+    std::function<void(double)>&& callback) {
+  enqueueOperation(
+      [tag, callback = std::move(callback)](auto& animatedNodesManager) {
+        auto output = animatedNodesManager.getNodeOutput(tag);
+        RNOH_ASSERT(output.isDouble());
+        callback(output.asDouble());
+      });
 }
 
 void NativeAnimatedTurboModule::startListeningToAnimatedNodeValue(
     jsi::Runtime& rt,
-    react::Tag tag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.startListeningToAnimatedNodeValue(
-      tag, [this, tag, &rt](double value) {
-        this->emitDeviceEvent(
-            rt,
-            "onAnimatedValueUpdate",
-            [tag, value](jsi::Runtime& rt, std::vector<jsi::Value>& args) {
-              auto payload = jsi::Object(rt);
-              payload.setProperty(rt, "tag", tag);
-              payload.setProperty(rt, "value", value);
-              args.push_back(std::move(payload));
-            });
-      });
+    react::Tag tag,
+    AnimatedValueListenerOptions options) {
+  if (options.batched) {
+    enqueueOperation([this, tag, options](auto& animatedNodesManager) {
+      m_batchedValueListenerByTag[tag] = {options.throttleInterval, {}, {}};
+      animatedNodesManager.startListeningToAnimatedNodeValue(
+          tag, [this, tag](double value) {
+            auto it = m_batchedValueListenerByTag.find(tag);
+            if (it != m_batchedValueListenerByTag.end()) {
+              it->second.pendingValue = value;
+            }
+          });
+    });
+    return;
+  }
+  enqueueOperation([this, tag, &rt](auto& animatedNodesManager) {
+    m_batchedValueListenerByTag.erase(tag);
+    animatedNodesManager.startListeningToAnimatedNodeValue(
+        tag, [this, tag, &rt](double value) {
+          this->emitDeviceEvent(
+              rt,
+              "onAnimatedValueUpdate",
+              [tag, value](jsi::Runtime& rt, std::vector<jsi::Value>& args) {
+                auto payload = jsi::Object(rt);
+                payload.setProperty(rt, "tag", tag);
+                payload.setProperty(rt, "value", value);
+                args.push_back(std::move(payload));
+              });
+        });
+  });
 }
 
 void NativeAnimatedTurboModule::stopListeningToAnimatedNodeValue(
     react::Tag tag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.stopListeningToAnimatedNodeValue(tag);
+  enqueueOperation([this, tag](auto& animatedNodesManager) {
+    m_batchedValueListenerByTag.erase(tag);
+    animatedNodesManager.stopListeningToAnimatedNodeValue(tag);
+  });
 }
 
 void NativeAnimatedTurboModule::connectAnimatedNodes(
     react::Tag parentNodeTag,
     react::Tag childNodeTag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.connectNodes(parentNodeTag, childNodeTag);
+  enqueueOperation([parentNodeTag, childNodeTag](auto& animatedNodesManager) {
+    animatedNodesManager.connectNodes(parentNodeTag, childNodeTag);
+  });
 }
 
 void NativeAnimatedTurboModule::disconnectAnimatedNodes(
     react::Tag parentNodeTag,
     react::Tag childNodeTag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.disconnectNodes(parentNodeTag, childNodeTag);
+  enqueueOperation([parentNodeTag, childNodeTag](auto& animatedNodesManager) {
+    animatedNodesManager.disconnectNodes(parentNodeTag, childNodeTag);
+  });
 }
 
 void NativeAnimatedTurboModule::startAnimatingNode(
@@ -581,78 +684,95 @@ void NativeAnimatedTurboModule::startAnimatingNode(
     react::Tag nodeTag,
     folly::dynamic const& config,
     EndCallback&& endCallback) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.startAnimatingNode(
-      animationId, nodeTag, config, std::move(endCallback));
+  enqueueOperation([animationId,
+                    nodeTag,
+                    config,
+                    endCallback = std::move(endCallback)](
+                       auto& animatedNodesManager) mutable {
+    animatedNodesManager.startAnimatingNode(
+        animationId, nodeTag, config, std::move(endCallback));
+  });
 }
 
 void NativeAnimatedTurboModule::stopAnimation(react::Tag animationId) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.stopAnimation(animationId);
+  enqueueOperation([animationId](auto& animatedNodesManager) {
+    animatedNodesManager.stopAnimation(animationId);
+  });
 }
 
 void NativeAnimatedTurboModule::setAnimatedNodeValue(
     react::Tag nodeTag,
     double value) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.setValue(nodeTag, value);
+  enqueueOperation([nodeTag, value](auto& animatedNodesManager) {
+    animatedNodesManager.setValue(nodeTag, value);
+  });
 }
 
 void NativeAnimatedTurboModule::setAnimatedNodeOffset(
     react::Tag nodeTag,
     double offset) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.setOffset(nodeTag, offset);
+  enqueueOperation([nodeTag, offset](auto& animatedNodesManager) {
+    animatedNodesManager.setOffset(nodeTag, offset);
+  });
 }
 
 void NativeAnimatedTurboModule::flattenAnimatedNodeOffset(react::Tag nodeTag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.flattenOffset(nodeTag);
+  enqueueOperation([nodeTag](auto& animatedNodesManager) {
+    animatedNodesManager.flattenOffset(nodeTag);
+  });
 }
 
 void NativeAnimatedTurboModule::extractAnimatedNodeOffset(react::Tag nodeTag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.extractOffset(nodeTag);
+  enqueueOperation([nodeTag](auto& animatedNodesManager) {
+    animatedNodesManager.extractOffset(nodeTag);
+  });
 }
 
 void NativeAnimatedTurboModule::connectAnimatedNodeToView(
     react::Tag nodeTag,
     react::Tag viewTag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.connectNodeToView(nodeTag, viewTag);
+  enqueueOperation([nodeTag, viewTag](auto& animatedNodesManager) {
+    animatedNodesManager.connectNodeToView(nodeTag, viewTag);
+  });
 }
 
 void NativeAnimatedTurboModule::disconnectAnimatedNodeFromView(
     react::Tag nodeTag,
     react::Tag viewTag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.disconnectNodeFromView(nodeTag, viewTag);
+  enqueueOperation([nodeTag, viewTag](auto& animatedNodesManager) {
+    animatedNodesManager.disconnectNodeFromView(nodeTag, viewTag);
+  });
 }
 
 void NativeAnimatedTurboModule::restoreDefaultValues(react::Tag nodeTag) {}
 
 void NativeAnimatedTurboModule::dropAnimatedNode(react::Tag tag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.dropNode(tag);
+  enqueueOperation([tag](auto& animatedNodesManager) {
+    animatedNodesManager.dropNode(tag);
+  });
 }
 
 void NativeAnimatedTurboModule::addAnimatedEventToView(
     react::Tag viewTag,
     std::string const& eventName,
     folly::dynamic const& eventMapping) {
-  auto lock = acquireLock();
   initializeEventListener();
-  m_animatedNodesManager.addAnimatedEventToView(
-      viewTag, eventName, eventMapping);
+  enqueueOperation([viewTag, eventName, eventMapping](
+                       auto& animatedNodesManager) {
+    animatedNodesManager.addAnimatedEventToView(
+        viewTag, eventName, eventMapping);
+  });
 }
 
 void NativeAnimatedTurboModule::removeAnimatedEventFromView(
     facebook::react::Tag viewTag,
     std::string const& eventName,
     facebook::react::Tag animatedValueTag) {
-  auto lock = acquireLock();
-  m_animatedNodesManager.removeAnimatedEventFromView(
-      viewTag, eventName, animatedValueTag);
+  enqueueOperation([viewTag, eventName, animatedValueTag](
+                       auto& animatedNodesManager) {
+    animatedNodesManager.removeAnimatedEventFromView(
+        viewTag, eventName, animatedValueTag);
+  });
 }
 
 void NativeAnimatedTurboModule::addListener(const std::string& eventName) {}
@@ -663,7 +783,14 @@ void NativeAnimatedTurboModule::runUpdates(long long frameTimeNanos) {
   ArkJS arkJS(m_ctx.env);
   auto lock = this->acquireLock();
   try {
+    applyOperationBatches();
     auto tagsToUpdate = this->m_animatedNodesManager.runUpdates(frameTimeNanos);
+    // a batch pushed while the frame callback was being stopped still needs
+    // a frame
+    if (!m_operationBatches.empty()) {
+      startDisplaySoloist();
+    }
+    flushBatchedValueUpdates();
 
     if (m_ctx.taskExecutor->isOnTaskThread(TaskThread::MAIN)) {
       this->setNativeProps(tagsToUpdate);
@@ -736,14 +863,85 @@ void NativeAnimatedTurboModule::emitAnimationGetValueEvent(
       });
 }
 
+bool NativeAnimatedTurboModule::hasPendingBatchedValues() const {
+  return std::any_of(
+      m_batchedValueListenerByTag.begin(),
+      m_batchedValueListenerByTag.end(),
+      [](auto const& entry) { return entry.second.pendingValue.has_value(); });
+}
+
+void NativeAnimatedTurboModule::flushBatchedValueUpdates() {
+  if (m_batchedValueListenerByTag.empty()) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  std::vector<double> tagsAndValues;
+  bool hasThrottledValues = false;
+  for (auto& [tag, listener] : m_batchedValueListenerByTag) {
+    if (!listener.pendingValue.has_value()) {
+      continue;
+    }
+    if (now - listener.lastEmitTime < listener.throttleInterval) {
+      hasThrottledValues = true;
+      continue;
+    }
+    tagsAndValues.push_back(tag);
+    tagsAndValues.push_back(listener.pendingValue.value());
+    listener.pendingValue.reset();
+    listener.lastEmitTime = now;
+  }
+  // values throttled outside of the frame callback, e.g. by a component
+  // event, need a frame to be delivered on
+  if (hasThrottledValues) {
+    startDisplaySoloist();
+  }
+  if (tagsAndValues.empty()) {
+    return;
+  }
+  // the runtime is provided by the jsInvoker when the event is emitted on the
+  // JS thread, so no runtime reference is kept between frames
+  emitDeviceEvent(
+      "onAnimatedValuesUpdate",
+      [tagsAndValues = std::move(tagsAndValues)](
+          jsi::Runtime& rt, std::vector<jsi::Value>& args) {
+        auto float64Array =
+            rt.global()
+                .getPropertyAsFunction(rt, "Float64Array")
+                .callAsConstructor(rt, static_cast<int>(tagsAndValues.size()))
+                .getObject(rt);
+        // a freshly constructed typed array starts at offset 0 of its buffer
+        auto buffer =
+            float64Array.getPropertyAsObject(rt, "buffer").getArrayBuffer(rt);
+        std::memcpy(
+            buffer.data(rt),
+            tagsAndValues.data(),
+            tagsAndValues.size() * sizeof(double));
+        args.emplace_back(std::move(float64Array));
+      });
+}
+
 void NativeAnimatedTurboModule::handleEvent(
     EventEmitRequestHandler::Context const& ctx) {
   ArkJS arkJS(ctx.env);
-  folly::dynamic payload = arkJS.getDynamic(ctx.payload);
-  react::Tag tag = ctx.tag;
-  const auto& eventName = ctx.eventName;
-
-  handleComponentEvent(tag, eventName, payload);
+  // only the numbers mapped by event drivers are read from the payload, most
+  // events aren't mapped at all
+  handleComponentEvent(
+      ctx.tag,
+      ctx.eventName,
+      [&](EventAnimationDriver::EventPath const& eventPath)
+          -> std::optional<double> {
+        auto value = ctx.payload;
+        for (auto const& key : eventPath) {
+          if (arkJS.getType(value) != napi_object) {
+            return std::nullopt;
+          }
+          value = arkJS.getObjectProperty(value, key);
+        }
+        if (arkJS.getType(value) != napi_number) {
+          return std::nullopt;
+        }
+        return arkJS.getDouble(value);
+      });
 }
 
 void NativeAnimatedTurboModule::initializeEventListener() {
@@ -759,9 +957,27 @@ void NativeAnimatedTurboModule::handleComponentEvent(
     facebook::react::Tag tag,
     std::string const& eventName,
     folly::dynamic payload) {
+  if (!m_hasEventDrivers) {
+    return;
+  }
   auto lock = acquireLock();
   auto propUpdates =
       m_animatedNodesManager.handleEvent(tag, eventName, payload);
+  flushBatchedValueUpdates();
+  setNativeProps(propUpdates);
+}
+
+void NativeAnimatedTurboModule::handleComponentEvent(
+    facebook::react::Tag tag,
+    std::string const& eventName,
+    EventAnimationDriver::EventValueGetter const& getEventValue) {
+  if (!m_hasEventDrivers) {
+    return;
+  }
+  auto lock = acquireLock();
+  auto propUpdates =
+      m_animatedNodesManager.handleEvent(tag, eventName, getEventValue);
+  flushBatchedValueUpdates();
   setNativeProps(propUpdates);
 }
 
@@ -12,12 +12,30 @@
 #include <native_display_soloist/native_display_soloist.h>
 #include <react/renderer/core/EventListener.h>
 #include <react/renderer/core/ReactPrimitives.h>
+#include <chrono>
 #include <mutex>
+#include <optional>
+#include <unordered_map>
 
 #include "AnimatedNodesManager.h"
+#include "RNOH/SPSCQueue.h"
 
 namespace rnoh {
 
+struct AnimatedValueListenerOptions {
+  /**
+   * Delivers the value through `onAnimatedValuesUpdate`, together with the
+   * values of the other batched listeners updated in the same frame,
+   * instead of one `onAnimatedValueUpdate` event per update.
+   */
+  bool batched = false;
+  /**
+   * Minimum time between two deliveries of a batched listener. Updates in
+   * between are coalesced and only the latest value is delivered.
+   */
+  std::chrono::milliseconds throttleInterval{0};
+};
+
 class NativeAnimatedTurboModule
     : public rnoh::ArkTSTurboModule,
       public rnoh::EventEmitRequestHandler,
@@ -67,11 +85,18 @@ class NativeAnimatedTurboModule
       facebook::react::Tag tag,
       facebook::jsi::Value const& config);
 
-  double getValue(facebook::react::Tag tag);
+  /**
+   * @brief Calls `callback` with the value of the node once pending
+   * operations have been applied, on the animation frame thread.
+   */
+  void getValue(
+      facebook::react::Tag tag,
+      std::function<void(double)>&& callback);
 
   void startListeningToAnimatedNodeValue(
       facebook::jsi::Runtime& rt,
-      facebook::react::Tag tag);
+      facebook::react::Tag tag,
+      AnimatedValueListenerOptions options = {});
 
   void stopListeningToAnimatedNodeValue(facebook::react::Tag tag);
 
@@ -149,6 +174,11 @@ class NativeAnimatedTurboModule
       std::string const& eventName,
       folly::dynamic payload);
 
+  void handleComponentEvent(
+      facebook::react::Tag tag,
+      std::string const& eventName,
+      EventAnimationDriver::EventValueGetter const& getEventValue);
+
   std::weak_ptr<facebook::react::CallbackWrapper> createCallbackWrapper(
       facebook::jsi::Function&& callback,
       facebook::jsi::Runtime& runtime);
@@ -156,10 +186,39 @@ class NativeAnimatedTurboModule
   EndCallback wrapEndCallbackWithJSInvoker(EndCallback&& callback);
 
  private:
+  using Operation = std::function<void(AnimatedNodesManager&)>;
+
   std::unique_lock<std::mutex> acquireLock() {
     return std::unique_lock(m_nodesManagerLock);
   }
 
+  /**
+   * @thread: JS
+   * Operations from JS are applied at the start of the next animation frame,
+   * so the frame never waits for JS to release the nodes manager.
+   */
+  void enqueueOperation(Operation&& operation);
+
+  /**
+   * @thread: JS
+   */
+  void flushOperationBatch();
+
+  void applyOperationBatches();
+
+  /**
+   * Emits the values of batched listeners updated since the last call as a
+   * single `onAnimatedValuesUpdate` event, carrying a Float64Array of
+   * interleaved (tag, value) pairs.
+   */
+  void flushBatchedValueUpdates();
+
+  /**
+   * Whether a batched listener has a value which wasn't emitted yet, e.g.
+   * because it's throttled. Keeps the frame callback running until it is.
+   */
+  bool hasPendingBatchedValues() const;
+
   void setDisplaySoloistFrameRate(int32_t frameRate);
 
   void startDisplaySoloist();
@@ -177,8 +236,27 @@ class NativeAnimatedTurboModule
   std::unique_ptr<OH_DisplaySoloist, decltype(&OH_DisplaySoloist_Destroy)>
       m_nativeDisplaySoloist;
   std::atomic<bool> m_isDisplaySoloistRegistered{false};
+  // DisplaySoloist is started from JS and stopped by the frame callback
+  std::mutex m_displaySoloistLock;
   AnimatedNodesManager m_animatedNodesManager;
+  // shared by the frame callback and component events, never taken on JS
   std::mutex m_nodesManagerLock;
+  // mirrors m_animatedNodesManager.hasEventDrivers(), so that component
+  // events can be dropped without taking m_nodesManagerLock
+  std::atomic<bool> m_hasEventDrivers{false};
+  // produced on JS, consumed by the frame callback
+  SPSCQueue<std::vector<Operation>> m_operationBatches;
+  std::vector<Operation> m_operationBatch;
+  bool m_isBatchingOperations = false;
+
+  struct BatchedValueListener {
+    std::chrono::milliseconds throttleInterval;
+    std::chrono::steady_clock::time_point lastEmitTime;
+    std::optional<double> pendingValue;
+  };
+  // guarded by m_nodesManagerLock
+  std::unordered_map<facebook::react::Tag, BatchedValueListener>
+      m_batchedValueListenerByTag;
   bool m_initializedEventListener = false;
 };
 
@@ -173,7 +173,8 @@ void TextInputEventEmitter::onKeyPress(
 }
 
 void TextInputEventEmitter::onScroll(const Metrics& textInputMetrics) const {
-  dispatchEvent("scroll", [textInputMetrics](jsi::Runtime& runtime) {
+  // scroll is continuous, only the latest event per EventBeat matters
+  dispatchUniqueEvent("scroll", [textInputMetrics](jsi::Runtime& runtime) {
     return textInputMetricsScrollPayload(runtime, textInputMetrics);
   });
 }
@@ -6,10 +6,122 @@
  */
 
 #include "TextLayoutManager.h"
+#include <react/utils/hash_combine.h>
+#include <atomic>
+#include <cmath>
 
 namespace facebook {
 namespace react {
 
+/*
+ * Measurements cached per text, one for each distinct set of layout
+ * constraints the text was measured with.
+ */
+constexpr auto kMeasureCacheEntriesPerKeyCap = size_t{4};
+
+/*
+ * Counted across all TextLayoutManagers, like the text storages they share
+ * through their delegates.
+ */
+static std::atomic<size_t> measureCacheSize{0};
+static std::atomic<uint64_t> measureCacheExactHits{0};
+static std::atomic<uint64_t> measureCacheConstraintHits{0};
+static std::atomic<uint64_t> measureCacheMisses{0};
+
+TextLayoutManager::~TextLayoutManager() {
+  measureCacheSize -= m_measureCache.size();
+}
+
+bool TextLayoutManager::MeasureCacheKey::operator==(
+    const MeasureCacheKey& other) const {
+  auto& fragments = attributedString.getFragments();
+  auto& otherFragments = other.attributedString.getFragments();
+  if (fragments.size() != otherFragments.size()) {
+    return false;
+  }
+  for (auto i = size_t{0}; i < fragments.size(); i++) {
+    auto& fragment = fragments[i];
+    auto& otherFragment = otherFragments[i];
+    if (!(fragment.string == otherFragment.string &&
+          fragment.textAttributes == otherFragment.textAttributes &&
+          // LayoutMetrics of an attachment fragment affects the size of a
+          // measured attributed string.
+          (!fragment.isAttachment() ||
+           (fragment.parentShadowView.layoutMetrics ==
+            otherFragment.parentShadowView.layoutMetrics)))) {
+      return false;
+    }
+  }
+  return paragraphAttributes == other.paragraphAttributes &&
+      pointScaleFactor == other.pointScaleFactor &&
+      measurementRevision == other.measurementRevision;
+}
+
+size_t TextLayoutManager::MeasureCacheKey::Hasher::operator()(
+    const MeasureCacheKey& key) const {
+  auto seed = size_t{0};
+  for (const auto& fragment : key.attributedString.getFragments()) {
+    hash_combine(seed, fragment.string, fragment.textAttributes);
+  }
+  hash_combine(
+      seed,
+      key.paragraphAttributes,
+      key.pointScaleFactor,
+      key.measurementRevision);
+  return seed;
+}
+
+/*
+ * Only the maximum width affects line breaking: the text is laid out with an
+ * unbounded height, unless it's scaled to fit. A line is broken only where
+ * the text doesn't fit the maximum width, so if the widest line fits the new
+ * maximum width, and the new maximum width isn't wider than the one used for
+ * the measurement, the text is broken into the same lines.
+ */
+bool TextLayoutManager::canReuseLines(
+    const ParagraphAttributes& paragraphAttributes,
+    const LayoutConstraints& measuredLayoutConstraints,
+    Float measuredWidth,
+    const LayoutConstraints& layoutConstraints) {
+  if (paragraphAttributes.adjustsFontSizeToFit ||
+      measuredLayoutConstraints.layoutDirection !=
+          layoutConstraints.layoutDirection) {
+    return false;
+  }
+  auto maxWidth = layoutConstraints.maximumSize.width;
+  auto measuredMaxWidth = measuredLayoutConstraints.maximumSize.width;
+  // non-positive and NaN widths don't constrain the layout
+  if (std::isnan(maxWidth) || maxWidth <= 0) {
+    return false;
+  }
+  auto wasMeasuredUnconstrained = std::isnan(measuredMaxWidth) ||
+      measuredMaxWidth <= 0 || std::isinf(measuredMaxWidth);
+  return measuredWidth <= maxWidth &&
+      (wasMeasuredUnconstrained || maxWidth <= measuredMaxWidth);
+}
+
+/*
+ * A cached measurement is clamped to the minimum size it was measured with,
+ * so unlike the lines, it can only be reused for the same minimum size.
+ */
+bool TextLayoutManager::canReuseMeasurement(
+    const MeasureCacheEntry& entry,
+    const ParagraphAttributes& paragraphAttributes,
+    const LayoutConstraints& layoutConstraints) {
+  auto& measuredLayoutConstraints = entry.layoutConstraints;
+  if (measuredLayoutConstraints == layoutConstraints) {
+    return true;
+  }
+  if (measuredLayoutConstraints.minimumSize != layoutConstraints.minimumSize) {
+    return false;
+  }
+  return canReuseLines(
+      paragraphAttributes,
+      measuredLayoutConstraints,
+      entry.measurement.size.width,
+      layoutConstraints);
+}
+
 void* TextLayoutManager::getNativeTextLayoutManager() const {
   return (void*)m_textLayoutManagerDelegate.get();
 }
@@ -19,17 +131,75 @@ TextMeasurement TextLayoutManager::measure(
     const ParagraphAttributes& paragraphAttributes,
     const TextLayoutContext& layoutContext,
     LayoutConstraints layoutConstraints) const {
-  return m_textLayoutManagerDelegate->measure(
+  if (attributedStringBox.getMode() != AttributedStringBox::Mode::Value) {
+    return m_textLayoutManagerDelegate->measure(
+        attributedStringBox,
+        paragraphAttributes,
+        layoutContext,
+        std::move(layoutConstraints));
+  }
+  MeasureCacheKey key{
+      attributedStringBox.getValue(),
+      paragraphAttributes,
+      layoutContext.pointScaleFactor,
+      m_textLayoutManagerDelegate->getMeasurementRevision()};
+  {
+    std::lock_guard<std::mutex> lock(m_measureCacheMtx);
+    auto it = m_measureCache.find(key);
+    if (it != m_measureCache.end()) {
+      for (const auto& entry : it->second) {
+        if (canReuseMeasurement(
+                entry, paragraphAttributes, layoutConstraints)) {
+          if (entry.layoutConstraints == layoutConstraints) {
+            measureCacheExactHits++;
+          } else {
+            measureCacheConstraintHits++;
+          }
+          return entry.measurement;
+        }
+      }
+    }
+  }
+
+  auto measurement = m_textLayoutManagerDelegate->measure(
       attributedStringBox,
       paragraphAttributes,
       layoutContext,
-      std::move(layoutConstraints));
+      layoutConstraints);
+
+  std::lock_guard<std::mutex> lock(m_measureCacheMtx);
+  measureCacheMisses++;
+  auto it = m_measureCache.find(key);
+  if (it == m_measureCache.end()) {
+    std::vector<MeasureCacheEntry> entries{
+        MeasureCacheEntry{layoutConstraints, measurement}};
+    // setting a new key may evict the least recently used one
+    auto previousSize = m_measureCache.size();
+    m_measureCache.set(std::move(key), std::move(entries));
+    measureCacheSize += m_measureCache.size() - previousSize;
+    return measurement;
+  }
+  auto& entries = it->second;
+  if (entries.size() >= kMeasureCacheEntriesPerKeyCap) {
+    entries.erase(entries.begin());
+  }
+  entries.push_back({layoutConstraints, measurement});
+  return measurement;
+}
+
+auto TextLayoutManager::getMeasureCacheStats() -> MeasureCacheStats {
+  return {
+      measureCacheSize.load(),
+      measureCacheExactHits.load(),
+      measureCacheConstraintHits.load(),
+      measureCacheMisses.load()};
 }
 
 TextMeasurement TextLayoutManager::measureCachedSpannableById(
     int64_t /*cacheId*/,
     const ParagraphAttributes& /*paragraphAttributes*/,
     LayoutConstraints /*layoutConstraints*/) const {
+  // texts aren't stored by cache ID on Harmony, see the declaration
   return {};
 }
 
@@ -42,10 +212,11 @@ LinesMeasurements TextLayoutManager::measureLines(
 }
 
 Float TextLayoutManager::baseline(
-    const AttributedStringBox& /*attributedStringBox*/,
-    const ParagraphAttributes& /*paragraphAttributes*/,
-    const Size& /*size*/) const {
-  return 0;
+    const AttributedStringBox& attributedStringBox,
+    const ParagraphAttributes& paragraphAttributes,
+    const Size& size) const {
+  return m_textLayoutManagerDelegate->baseline(
+      attributedStringBox, paragraphAttributes, size);
 }
 
 } // namespace react
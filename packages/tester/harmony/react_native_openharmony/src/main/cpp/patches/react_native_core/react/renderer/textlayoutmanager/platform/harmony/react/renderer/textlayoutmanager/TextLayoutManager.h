@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <folly/container/EvictingCacheMap.h>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <react/renderer/attributedstring/AttributedString.h>
 #include <react/renderer/attributedstring/AttributedStringBox.h>
@@ -36,6 +39,22 @@ class TextLayoutManagerDelegate {
       const AttributedStringBox& attributedStringBox,
       const ParagraphAttributes& paragraphAttributes,
       const Size& size) = 0;
+
+  virtual Float baseline(
+      const AttributedStringBox& /*attributedStringBox*/,
+      const ParagraphAttributes& /*paragraphAttributes*/,
+      const Size& /*size*/) {
+    return 0;
+  }
+
+  /*
+   * Changes whenever previously returned measurements may have become stale,
+   * e.g. after the font scale changed or a font was registered.
+   * TextLayoutManager drops cached measurements of older revisions.
+   */
+  virtual size_t getMeasurementRevision() const {
+    return 0;
+  }
 };
 
 /*
@@ -43,6 +62,16 @@ class TextLayoutManagerDelegate {
  */
 class TextLayoutManager {
  public:
+  struct MeasureCacheStats {
+    size_t size;
+    // measured with the same layout constraints
+    uint64_t exactHits;
+    // measured with different layout constraints that provably give the same
+    // result
+    uint64_t constraintHits;
+    uint64_t misses;
+  };
+
   TextLayoutManager(const ContextContainer::Shared& contextContainer)
       : m_measureCache(kSimpleThreadSafeCacheSizeCap) {
     m_textLayoutManagerDelegate =
@@ -50,6 +79,8 @@ class TextLayoutManager {
             "textLayoutManagerDelegate");
   }
 
+  virtual ~TextLayoutManager();
+
   /*
    * Measures `attributedStringBox` using native text rendering infrastructure.
    */
@@ -62,6 +93,8 @@ class TextLayoutManager {
   /**
    * Measures an AttributedString on the platform, as identified by some
    * opaque cache ID.
+   * Not implemented on Harmony: the platform doesn't assign cache IDs to
+   * texts, so an empty measurement is always returned.
    */
   virtual TextMeasurement measureCachedSpannableById(
       int64_t cacheId,
@@ -92,9 +125,59 @@ class TextLayoutManager {
       const ParagraphAttributes& paragraphAttributes,
       const Size& size) const;
 
+  /*
+   * Returns the statistics of the measure caches of all TextLayoutManagers
+   * in the process. Thread-safe.
+   */
+  static MeasureCacheStats getMeasureCacheStats();
+
+  /*
+   * Whether a text laid out with `measuredLayoutConstraints`, whose widest
+   * line is `measuredWidth` wide, is broken into the same lines with
+   * `layoutConstraints`. Shared by the measure cache and the text storages of
+   * the delegate.
+   */
+  static bool canReuseLines(
+      const ParagraphAttributes& paragraphAttributes,
+      const LayoutConstraints& measuredLayoutConstraints,
+      Float measuredWidth,
+      const LayoutConstraints& layoutConstraints);
+
  private:
+  /*
+   * Identifies measured text regardless of the layout constraints, which are
+   * compared per entry.
+   */
+  struct MeasureCacheKey {
+    AttributedString attributedString;
+    ParagraphAttributes paragraphAttributes;
+    Float pointScaleFactor;
+    size_t measurementRevision;
+
+    bool operator==(const MeasureCacheKey& other) const;
+
+    struct Hasher {
+      size_t operator()(const MeasureCacheKey& key) const;
+    };
+  };
+
+  struct MeasureCacheEntry {
+    LayoutConstraints layoutConstraints;
+    TextMeasurement measurement;
+  };
+
+  static bool canReuseMeasurement(
+      const MeasureCacheEntry& entry,
+      const ParagraphAttributes& paragraphAttributes,
+      const LayoutConstraints& layoutConstraints);
+
   std::shared_ptr<TextLayoutManagerDelegate> m_textLayoutManagerDelegate;
-  TextMeasureCache m_measureCache;
+  mutable std::mutex m_measureCacheMtx;
+  mutable folly::EvictingCacheMap<
+      MeasureCacheKey,
+      std::vector<MeasureCacheEntry>,
+      MeasureCacheKey::Hasher>
+      m_measureCache;
 };
 
 } // namespace react
@@ -28,7 +28,11 @@ import { JsBundle } from './JSBundleProvider';
 import { RNOHErrorStack } from './RNOHError';
 
 
-export type CppFeatureFlag = "PARTIAL_SYNC_OF_DESCRIPTOR_REGISTRY" | "WORKER_THREAD_ENABLED"
+export type CppFeatureFlag =
+  "PARTIAL_SYNC_OF_DESCRIPTOR_REGISTRY"
+  | "WORKER_THREAD_ENABLED"
+  | "SHARED_JS_THREAD_ENABLED"
+  | "TEXT_PRE_MEASUREMENT_ENABLED"
 
 type RawRNOHError = {
   message: string,
@@ -137,6 +141,31 @@ export class NapiBridge {
     this.libRNOHApp?.resumeDebugger(instanceId)
   }
 
+  /**
+   * Keeps `count` JS runtimes prewarmed in the background. RN instances created afterwards with the same
+   * `jsvmInitOptions` and `useSharedJSThread` reuse them instead of creating their own. `preludeBundlePath` points
+   * to a plain JS file evaluated in every prewarmed runtime.
+   */
+  prewarmRNInstances(
+    envId: number,
+    count: number,
+    jsvmInitOptions: ReadonlyArray<JSVMInitOption>,
+    preludeBundlePath: string = "",
+    useSharedJSThread: boolean = false,
+  ) {
+    return this.unwrapResult(this.libRNOHApp?.prewarmRNInstances(envId, count, jsvmInitOptions, preludeBundlePath,
+      useSharedJSThread))
+  }
+
+  /**
+   * Makes RN instances created afterwards create Turbo Modules accessed early in the previous session when their
+   * JS thread is idle, and record the ones accessed during the first `recordingDurationMs` of this session to
+   * `filePath`.
+   */
+  configureTurboModuleWarmSet(filePath: string, recordingDurationMs: number) {
+    return this.unwrapResult(this.libRNOHApp?.configureTurboModuleWarmSet(filePath, recordingDurationMs))
+  }
+
   onCreateRNInstance(
     envId: number,
     instanceId: number,
@@ -222,6 +251,15 @@ export class NapiBridge {
     return this.unwrapResult(result)
   }
 
+  /**
+   * Registers where a segment of a segmented bundle is stored. The segment is evaluated when JS requires one of its
+   * modules for the first time. Segments of a bundle loaded from `/path/index.bundle` are looked up in
+   * `/path/index.bundle.segments/<segmentId>.bundle` unless registered explicitly.
+   */
+  registerSegment(instanceId: number, segmentId: number, segmentPath: string) {
+    return this.unwrapResult(this.libRNOHApp?.registerSegment(instanceId, segmentId, segmentPath))
+  }
+
   updateSurfaceConstraints(
     instanceId: number,
     surfaceTag: number,
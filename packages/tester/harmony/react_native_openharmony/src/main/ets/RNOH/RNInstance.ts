@@ -438,6 +438,19 @@ export type RNInstanceOptions = {
    * Specifies custom init options used by JSVM. The options has no effect if using Hermes.
    */
   jsvmInitOptions?: ReadonlyArray<JSVMInitOption>;
+  /**
+   * @default: false
+   * Runs the JS of this instance on a thread shared with other instances created with this option, instead of on
+   * a dedicated thread. Instances take turns, one task at a time. Intended for lightweight secondary instances,
+   * e.g. widgets, where a thread per instance costs more than it gives. The option has no effect if using JSVM.
+   */
+  useSharedJSThread?: boolean;
+  /**
+   * @default: false
+   * Measures the texts of a committed shadow tree on several threads before the layout, so that the layout mostly
+   * reuses their measurements. Helps screens that render many texts at once, at the cost of extra CPU time.
+   */
+  enableTextPreMeasurement?: boolean;
   /**
    * @architecture: ArkTS
    * Enables text measurement using NDK (C++) interface.
@@ -534,6 +547,8 @@ export class RNInstanceImpl implements RNInstance {
     private _httpClient: HttpClient,
     backPressHandler?: () => void,
     private jsvmInitOptions?: ReadonlyArray<JSVMInitOption>,
+    private shouldUseSharedJSThread: boolean = false,
+    private shouldEnableTextPreMeasurement: boolean = false,
   ) {
     this.defaultProps = { concurrentRoot: !disableConcurrentRoot };
     this.logger = injectedLogger.clone('RNInstance');
@@ -637,6 +652,12 @@ export class RNInstanceImpl implements RNInstance {
     if (this.workerThread != undefined) {
       cppFeatureFlags.push('WORKER_THREAD_ENABLED');
     }
+    if (this.shouldUseSharedJSThread) {
+      cppFeatureFlags.push('SHARED_JS_THREAD_ENABLED');
+    }
+    if (this.shouldEnableTextPreMeasurement) {
+      cppFeatureFlags.push('TEXT_PRE_MEASUREMENT_ENABLED');
+    }
     this.napiBridge.onCreateRNInstance(
       this.envId,
       this.id,
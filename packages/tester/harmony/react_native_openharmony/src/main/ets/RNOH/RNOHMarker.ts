@@ -73,6 +73,8 @@ export enum RNOHMarkerId {
   CREATE_MODULE_END,
   PROCESS_CORE_REACT_PACKAGE_START,
   PROCESS_CORE_REACT_PACKAGE_END,
+  PREWARM_REACT_INSTANCE_START,
+  PREWARM_REACT_INSTANCE_STOP,
   FABRIC_COMMIT_START,
   FABRIC_COMMIT_END,
   FABRIC_FINISH_TRANSACTION_START,
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include "RNOH/arkui/AttributeWriteCache.h"
+
+using namespace rnoh;
+
+namespace {
+
+enum class Attribute { WIDTH, HEIGHT, BORDER_WIDTH };
+
+/**
+ * Stands in for NativeNodeApi::setAttribute and records every write that
+ * reaches it.
+ */
+class RecordingNodeApi {
+ public:
+  struct Write {
+    Attribute attribute;
+    std::vector<float> values;
+  };
+
+  void setAttribute(Attribute attribute, std::vector<float> const& values) {
+    if (shouldFail) {
+      throw std::runtime_error("setAttribute failed");
+    }
+    writes.push_back({attribute, values});
+  }
+
+  std::vector<Write> writes;
+  bool shouldFail = false;
+};
+
+class AttributeWriteCacheTest : public ::testing::Test {
+ protected:
+  bool setAttributeIfChanged(
+      Attribute attribute,
+      std::vector<float> const& values) {
+    return cache.writeIfChanged(
+        attribute, values.data(), values.size(), [&] {
+          nodeApi.setAttribute(attribute, values);
+        });
+  }
+
+  RecordingNodeApi nodeApi;
+  AttributeWriteCache<Attribute, float, 4> cache;
+};
+
+} // namespace
+
+TEST_F(AttributeWriteCacheTest, writesFirstValue) {
+  EXPECT_TRUE(setAttributeIfChanged(Attribute::WIDTH, {100}));
+  ASSERT_EQ(nodeApi.writes.size(), 1);
+  EXPECT_EQ(nodeApi.writes[0].attribute, Attribute::WIDTH);
+  EXPECT_EQ(nodeApi.writes[0].values, std::vector<float>{100});
+}
+
+TEST_F(AttributeWriteCacheTest, skipsUnchangedValue) {
+  setAttributeIfChanged(Attribute::WIDTH, {100});
+  EXPECT_FALSE(setAttributeIfChanged(Attribute::WIDTH, {100}));
+  EXPECT_EQ(nodeApi.writes.size(), 1);
+}
+
+TEST_F(AttributeWriteCacheTest, writesChangedValue) {
+  setAttributeIfChanged(Attribute::WIDTH, {100});
+  EXPECT_TRUE(setAttributeIfChanged(Attribute::WIDTH, {200}));
+  EXPECT_TRUE(setAttributeIfChanged(Attribute::WIDTH, {100}));
+  EXPECT_EQ(nodeApi.writes.size(), 3);
+}
+
+TEST_F(AttributeWriteCacheTest, writesValueWithDifferentSize) {
+  setAttributeIfChanged(Attribute::BORDER_WIDTH, {1, 1});
+  EXPECT_TRUE(setAttributeIfChanged(Attribute::BORDER_WIDTH, {1, 1, 1}));
+  EXPECT_EQ(nodeApi.writes.size(), 2);
+}
+
+TEST_F(AttributeWriteCacheTest, cachesAttributesIndependently) {
+  setAttributeIfChanged(Attribute::WIDTH, {100});
+  EXPECT_TRUE(setAttributeIfChanged(Attribute::HEIGHT, {100}));
+  EXPECT_FALSE(setAttributeIfChanged(Attribute::WIDTH, {100}));
+  EXPECT_FALSE(setAttributeIfChanged(Attribute::HEIGHT, {100}));
+  EXPECT_EQ(nodeApi.writes.size(), 2);
+}
+
+TEST_F(AttributeWriteCacheTest, neverSkipsValuesAboveCapacity) {
+  std::vector<float> values = {1, 2, 3, 4, 5};
+  EXPECT_TRUE(setAttributeIfChanged(Attribute::BORDER_WIDTH, values));
+  EXPECT_TRUE(setAttributeIfChanged(Attribute::BORDER_WIDTH, values));
+  EXPECT_EQ(nodeApi.writes.size(), 2);
+}
+
+TEST_F(AttributeWriteCacheTest, doesNotSkipWriteAfterFailedWrite) {
+  setAttributeIfChanged(Attribute::WIDTH, {100});
+  nodeApi.shouldFail = true;
+  EXPECT_THROW(
+      setAttributeIfChanged(Attribute::WIDTH, {200}), std::runtime_error);
+  nodeApi.shouldFail = false;
+  // the native node may still hold 100, so it must be written again
+  EXPECT_TRUE(setAttributeIfChanged(Attribute::WIDTH, {100}));
+  EXPECT_EQ(nodeApi.writes.size(), 2);
+}
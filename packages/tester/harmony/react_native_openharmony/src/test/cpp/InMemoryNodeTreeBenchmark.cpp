@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "RNOH/arkui/InMemoryNodeTree.h"
+
+using namespace rnoh;
+
+namespace {
+
+enum class NodeType { STACK, TEXT };
+
+using Tree = InMemoryNodeTree<NodeType, float>;
+
+constexpr int32_t WIDTH = 0;
+constexpr int32_t HEIGHT = 1;
+
+/**
+ * Mounts a flat list of `range(0)` children, updates two attributes of
+ * each and unmounts them again: the node operations of a list appearing,
+ * relayouting and disappearing.
+ */
+void BM_MountUpdateDelete(benchmark::State& state) {
+  auto childCount = static_cast<size_t>(state.range(0));
+  Tree tree;
+  std::vector<Tree::Node*> children(childCount);
+  for (auto _ : state) {
+    auto root = tree.createNode(NodeType::STACK);
+    for (size_t i = 0; i < childCount; i++) {
+      children[i] = tree.createNode(NodeType::TEXT);
+      tree.insertChildAt(root, children[i], -1);
+    }
+    for (size_t i = 0; i < childCount; i++) {
+      float size = static_cast<float>(i);
+      tree.setAttribute(children[i], WIDTH, &size, 1, nullptr, nullptr);
+      tree.setAttribute(children[i], HEIGHT, &size, 1, nullptr, nullptr);
+    }
+    for (size_t i = childCount; i > 0; i--) {
+      tree.removeChild(root, children[i - 1]);
+      tree.disposeNode(children[i - 1]);
+    }
+    tree.disposeNode(root);
+  }
+  state.SetItemsProcessed(state.iterations() * childCount);
+}
+BENCHMARK(BM_MountUpdateDelete)->Arg(100)->Arg(1000)->Arg(10000);
+
+} // namespace
@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include "RNOH/arkui/InMemoryNodeTree.h"
+
+using namespace rnoh;
+
+namespace {
+
+enum class NodeType { STACK, TEXT };
+
+using Tree = InMemoryNodeTree<NodeType, float>;
+
+constexpr int32_t WIDTH = 0;
+
+} // namespace
+
+TEST(InMemoryNodeTreeTest, insertsChildrenAtPosition) {
+  Tree tree;
+  auto parent = tree.createNode(NodeType::STACK);
+  auto first = tree.createNode(NodeType::TEXT);
+  auto second = tree.createNode(NodeType::TEXT);
+  auto third = tree.createNode(NodeType::TEXT);
+
+  EXPECT_TRUE(tree.insertChildAt(parent, first, -1));
+  EXPECT_TRUE(tree.insertChildAt(parent, third, 5));
+  EXPECT_TRUE(tree.insertChildAt(parent, second, 1));
+
+  EXPECT_EQ(parent->children, (std::vector<Tree::Node*>{first, second, third}));
+  EXPECT_EQ(second->parent, parent);
+  EXPECT_EQ(tree.getStats().childOperations, 3);
+}
+
+TEST(InMemoryNodeTreeTest, reinsertingChildMovesItToTheNewParent) {
+  Tree tree;
+  auto oldParent = tree.createNode(NodeType::STACK);
+  auto newParent = tree.createNode(NodeType::STACK);
+  auto child = tree.createNode(NodeType::TEXT);
+  tree.insertChildAt(oldParent, child, -1);
+
+  tree.insertChildAt(newParent, child, -1);
+
+  EXPECT_TRUE(oldParent->children.empty());
+  EXPECT_EQ(child->parent, newParent);
+}
+
+TEST(InMemoryNodeTreeTest, removingChildOfAnotherParentFails) {
+  Tree tree;
+  auto parent = tree.createNode(NodeType::STACK);
+  auto other = tree.createNode(NodeType::STACK);
+  auto child = tree.createNode(NodeType::TEXT);
+  tree.insertChildAt(other, child, -1);
+
+  EXPECT_FALSE(tree.removeChild(parent, child));
+  EXPECT_EQ(child->parent, other);
+}
+
+TEST(InMemoryNodeTreeTest, disposingNodeDetachesButKeepsChildren) {
+  Tree tree;
+  auto grandparent = tree.createNode(NodeType::STACK);
+  auto parent = tree.createNode(NodeType::STACK);
+  auto child = tree.createNode(NodeType::TEXT);
+  tree.insertChildAt(grandparent, parent, -1);
+  tree.insertChildAt(parent, child, -1);
+
+  tree.disposeNode(parent);
+
+  EXPECT_FALSE(tree.contains(parent));
+  EXPECT_TRUE(grandparent->children.empty());
+  EXPECT_TRUE(tree.contains(child));
+  EXPECT_EQ(child->parent, nullptr);
+  EXPECT_EQ(tree.getLiveNodeCount(), 2);
+  EXPECT_EQ(tree.getStats().disposedNodes, 1);
+}
+
+TEST(InMemoryNodeTreeTest, operationsOnDisposedNodesFail) {
+  Tree tree;
+  auto parent = tree.createNode(NodeType::STACK);
+  auto child = tree.createNode(NodeType::TEXT);
+  tree.disposeNode(child);
+  float value = 1;
+
+  EXPECT_FALSE(tree.insertChildAt(parent, child, -1));
+  EXPECT_EQ(tree.setAttribute(child, WIDTH, &value, 1, nullptr, nullptr),
+            nullptr);
+  EXPECT_EQ(tree.getAttribute(child, WIDTH), nullptr);
+  EXPECT_FALSE(tree.resetAttribute(child, WIDTH));
+}
+
+TEST(InMemoryNodeTreeTest, recordsLastAttributeValueUntilReset) {
+  Tree tree;
+  auto node = tree.createNode(NodeType::TEXT);
+  float values[] = {10, 20};
+
+  tree.setAttribute(node, WIDTH, values, 2, "label", nullptr);
+  values[0] = 30;
+  tree.setAttribute(node, WIDTH, values, 1, nullptr, nullptr);
+
+  auto attribute = tree.getAttribute(node, WIDTH);
+  ASSERT_NE(attribute, nullptr);
+  EXPECT_EQ(attribute->values, std::vector<float>{30});
+  EXPECT_FALSE(attribute->hasString);
+  EXPECT_EQ(tree.getStats().attributeWrites, 2);
+
+  EXPECT_TRUE(tree.resetAttribute(node, WIDTH));
+  EXPECT_EQ(tree.getAttribute(node, WIDTH), nullptr);
+  EXPECT_EQ(tree.getStats().attributeResets, 1);
+}
+
+TEST(InMemoryNodeTreeTest, resetDisposesAllNodesAndClearsStats) {
+  Tree tree;
+  auto node = tree.createNode(NodeType::STACK);
+
+  tree.reset();
+
+  EXPECT_FALSE(tree.contains(node));
+  EXPECT_EQ(tree.getLiveNodeCount(), 0);
+  EXPECT_EQ(tree.getStats().createdNodes, 0);
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include "RNOH/TagIndexedMap.h"
+
+using namespace rnoh;
+
+namespace {
+
+using Tag = TagIndexedMap<int>::Tag;
+using Value = std::shared_ptr<int>;
+
+// roughly a large list screen
+constexpr Tag LIVE_TAG_COUNT = 50000;
+
+/**
+ * React allocates tags in steps of 2 on the JS side, so half of the slots
+ * in the tag range are never occupied.
+ */
+constexpr Tag toTag(Tag index) {
+  return index * 2 + 2;
+}
+
+template <typename Map>
+void insert(Map& map, Tag tag, Value value) {
+  if constexpr (std::is_same_v<Map, TagIndexedMap<Value>>) {
+    map.insertOrAssign(tag, std::move(value));
+  } else {
+    map.insert_or_assign(tag, std::move(value));
+  }
+}
+
+template <typename Map>
+bool contains(Map const& map, Tag tag) {
+  if constexpr (std::is_same_v<Map, TagIndexedMap<Value>>) {
+    return map.find(tag) != nullptr;
+  } else {
+    return map.find(tag) != map.end();
+  }
+}
+
+template <typename Map>
+void BM_Lookup(benchmark::State& state) {
+  Map map;
+  auto value = std::make_shared<int>(0);
+  for (Tag i = 0; i < LIVE_TAG_COUNT; i++) {
+    insert(map, toTag(i), value);
+  }
+  Tag i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(contains(map, toTag(i)));
+    i = (i + 7919) % LIVE_TAG_COUNT;
+  }
+}
+BENCHMARK(BM_Lookup<TagIndexedMap<Value>>);
+BENCHMARK(BM_Lookup<std::unordered_map<Tag, Value>>);
+
+/**
+ * Mounts and unmounts all 50k tags, as a surface being started and
+ * stopped does.
+ */
+template <typename Map>
+void BM_InsertErase(benchmark::State& state) {
+  auto value = std::make_shared<int>(0);
+  for (auto _ : state) {
+    Map map;
+    for (Tag i = 0; i < LIVE_TAG_COUNT; i++) {
+      insert(map, toTag(i), value);
+    }
+    for (Tag i = 0; i < LIVE_TAG_COUNT; i++) {
+      map.erase(toTag(i));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * LIVE_TAG_COUNT);
+}
+BENCHMARK(BM_InsertErase<TagIndexedMap<Value>>);
+BENCHMARK(BM_InsertErase<std::unordered_map<Tag, Value>>);
+
+} // namespace
@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2024 Huawei Technologies Co., Ltd.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include "RNOH/TagIndexedMap.h"
+
+using namespace rnoh;
+
+namespace {
+
+using Map = TagIndexedMap<std::string>;
+using Tag = Map::Tag;
+
+// one past the last tag stored in the paged slots; see TagIndexedMap
+constexpr Tag FIRST_FALLBACK_TAG = 1 << 24;
+
+std::map<Tag, std::string> toOrderedMap(Map const& map) {
+  std::map<Tag, std::string> result;
+  map.forEach([&](Tag tag, std::string const& value) { result[tag] = value; });
+  return result;
+}
+
+} // namespace
+
+TEST(TagIndexedMapTest, insertsAndAssigns) {
+  Map map;
+
+  EXPECT_TRUE(map.insertOrAssign(1, "a"));
+  EXPECT_FALSE(map.insertOrAssign(1, "b"));
+
+  ASSERT_NE(map.find(1), nullptr);
+  EXPECT_EQ(*map.find(1), "b");
+  EXPECT_EQ(map.size(), 1);
+}
+
+TEST(TagIndexedMapTest, missingTagsAreNotFound) {
+  Map map;
+  map.insertOrAssign(1, "a");
+
+  EXPECT_EQ(map.find(0), nullptr);
+  EXPECT_EQ(map.find(2), nullptr);
+  EXPECT_EQ(map.find(100000), nullptr);
+  EXPECT_FALSE(map.erase(2).has_value());
+}
+
+TEST(TagIndexedMapTest, keepsTagsAtPageBoundariesApart) {
+  Map map;
+  map.insertOrAssign(255, "last of first page");
+  map.insertOrAssign(256, "first of second page");
+  map.insertOrAssign(511, "last of second page");
+
+  EXPECT_EQ(map.erase(256), "first of second page");
+
+  EXPECT_EQ(*map.find(255), "last of first page");
+  EXPECT_EQ(map.find(256), nullptr);
+  EXPECT_EQ(*map.find(511), "last of second page");
+  EXPECT_EQ(map.size(), 2);
+}
+
+TEST(TagIndexedMapTest, reusesTagAfterItsPageWasReleased) {
+  Map map;
+  map.insertOrAssign(256, "old");
+  // the only value of the page, so erasing it releases the page
+  map.erase(256);
+
+  EXPECT_TRUE(map.insertOrAssign(256, "new"));
+
+  EXPECT_EQ(*map.find(256), "new");
+  EXPECT_EQ(map.size(), 1);
+}
+
+TEST(TagIndexedMapTest, storesNegativeTags) {
+  Map map;
+
+  map.insertOrAssign(-1, "negative");
+  map.insertOrAssign(1, "positive");
+
+  EXPECT_EQ(*map.find(-1), "negative");
+  EXPECT_EQ(map.erase(-1), "negative");
+  EXPECT_EQ(map.find(-1), nullptr);
+  EXPECT_EQ(map.size(), 1);
+}
+
+TEST(TagIndexedMapTest, storesTagsBeyondTheDenseRange) {
+  Map map;
+
+  map.insertOrAssign(FIRST_FALLBACK_TAG - 1, "dense");
+  map.insertOrAssign(FIRST_FALLBACK_TAG, "fallback");
+  EXPECT_FALSE(map.insertOrAssign(FIRST_FALLBACK_TAG, "assigned"));
+
+  EXPECT_EQ(*map.find(FIRST_FALLBACK_TAG - 1), "dense");
+  EXPECT_EQ(*map.find(FIRST_FALLBACK_TAG), "assigned");
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.erase(FIRST_FALLBACK_TAG), "assigned");
+  EXPECT_FALSE(map.contains(FIRST_FALLBACK_TAG));
+}
+
+TEST(TagIndexedMapTest, visitsEveryValue) {
+  Map map;
+  map.insertOrAssign(-5, "a");
+  map.insertOrAssign(3, "b");
+  map.insertOrAssign(300, "c");
+  map.insertOrAssign(FIRST_FALLBACK_TAG + 1, "d");
+
+  EXPECT_EQ(
+      toOrderedMap(map),
+      (std::map<Tag, std::string>{
+          {-5, "a"}, {3, "b"}, {300, "c"}, {FIRST_FALLBACK_TAG + 1, "d"}}));
+}
+
+TEST(TagIndexedMapTest, clearRemovesEverything) {
+  Map map;
+  map.insertOrAssign(1, "a");
+  map.insertOrAssign(-1, "b");
+
+  map.clear();
+
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.find(1), nullptr);
+  EXPECT_EQ(map.find(-1), nullptr);
+}